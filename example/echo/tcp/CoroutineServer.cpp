@@ -0,0 +1,79 @@
+#include <iostream>
+#include <vector>
+#include <optional>
+#include <system_error>
+#include "IoContext.h"
+#include "TcpListener.h"
+#include "TcpStream.h"
+
+// 每个连接一个协程，所有协程由同一个线程的 IoContext 驱动
+net::Task handle_client(net::TcpStream client)
+{
+    std::error_code ec;
+    std::vector<uint8_t> buffer(1024);
+
+    while (true)
+    {
+        size_t bytesRead = co_await client.async_read(buffer, ec);
+        if (ec || bytesRead == 0)
+        {
+            if (ec)
+                std::cerr << "Error reading from client: " << ec.message() << std::endl;
+            co_return;
+        }
+
+        // 回写收到的数据
+        net::ConstBuffer rest(buffer.data(), bytesRead);
+        while (rest.size() > 0)
+        {
+            size_t bytesWritten = co_await client.async_write(rest, ec);
+            if (ec)
+            {
+                std::cerr << "Error writing to client: " << ec.message() << std::endl;
+                co_return;
+            }
+            rest = rest.advance(bytesWritten);
+        }
+    }
+}
+
+net::Task accept_loop(net::TcpListener& listener)
+{
+    std::error_code ec;
+    while (true)
+    {
+        auto clientOpt = co_await listener.async_accept(ec);
+        if (!clientOpt)
+        {
+            std::cerr << "Failed to accept connection: " << ec.message() << std::endl;
+            ec.clear();
+            continue;
+        }
+
+        handle_client(std::move(*clientOpt));
+    }
+}
+
+int main()
+{
+    std::error_code ec;
+    // 启动监听
+    auto listenerOpt = net::TcpListener::bind("127.0.0.1", 9090, ec);
+    if (!listenerOpt)
+    {
+        std::cerr << "Failed to bind: " << ec.message() << std::endl;
+        return -1;
+    }
+
+    net::TcpListener listener = std::move(*listenerOpt);
+    std::cout << "Coroutine server listening on 127.0.0.1:9090" << std::endl;
+
+    accept_loop(listener);
+    net::IoContext::current().run(ec);
+    if (ec)
+    {
+        std::cerr << "Event loop stopped: " << ec.message() << std::endl;
+        return -1;
+    }
+    return 0;
+}
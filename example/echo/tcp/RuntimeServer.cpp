@@ -0,0 +1,71 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <system_error>
+#include "Runtime.h"
+#include "TcpListener.h"
+#include "TcpStream.h"
+
+// 一个连接的回显会话，回调链持有它的引用直到连接关闭
+struct Session : std::enable_shared_from_this<Session>
+{
+    explicit Session(net::TcpStream stream) : stream(std::move(stream)), buffer(1024) {}
+
+    void read()
+    {
+        auto self = shared_from_this();
+        stream.async_read(buffer, [self](size_t bytesRead, std::error_code ec)
+        {
+            if (ec || bytesRead == 0)
+                return;
+            self->write(net::ConstBuffer(self->buffer.data(), bytesRead));
+        });
+    }
+
+    void write(net::ConstBuffer rest)
+    {
+        auto self = shared_from_this();
+        stream.async_write(rest, [self, rest](size_t bytesWritten, std::error_code ec)
+        {
+            if (ec)
+                return;
+            if (bytesWritten < rest.size())
+                self->write(rest.advance(bytesWritten));
+            else
+                self->read();
+        });
+    }
+
+    net::TcpStream stream;
+    std::vector<uint8_t> buffer;
+};
+
+// 每个工作线程在自己的监听者上循环 accept
+void accept_next(net::TcpListener& listener)
+{
+    listener.async_accept([&listener](std::optional<net::TcpStream> client, std::error_code ec)
+    {
+        if (client)
+            std::make_shared<Session>(std::move(*client))->read();
+        else
+            std::cerr << "Failed to accept connection: " << ec.message() << std::endl;
+        accept_next(listener);
+    });
+}
+
+int main()
+{
+    std::error_code ec;
+    net::Runtime runtime;
+    net::RuntimeOptions options;
+
+    if (!runtime.serve("127.0.0.1", 9090, options, [](net::TcpListener& listener, unsigned) { accept_next(listener); }, ec))
+    {
+        std::cerr << "Failed to start runtime: " << ec.message() << std::endl;
+        return -1;
+    }
+
+    std::cout << "Runtime server listening on 127.0.0.1:9090 with " << runtime.size() << " workers" << std::endl;
+    runtime.join();
+    return 0;
+}
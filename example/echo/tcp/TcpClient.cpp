@@ -19,8 +19,7 @@ int main()
     // 发送数据
     net::TcpStream stream = std::move(*streamOpt);
     std::string message = "Hello from client!";
-    std::vector<uint8_t> data(message.begin(), message.end());
-    stream.write(data, ec);
+    stream.write_all(message, ec);
     if (ec)
     {
         std::cerr << "Error writing to server: " << ec.message() << std::endl;
@@ -25,8 +25,7 @@ void handle_client(net::TcpStream client)
 
         // 回写数据
         std::string response = "Hello from server!";
-        std::vector<uint8_t> responseData(response.begin(), response.end());
-        client.write(responseData, ec);
+        client.write_all(response, ec);
         if (ec)
         {
             std::cerr << "Error writing to client: " << ec.message() << std::endl;
@@ -24,10 +24,9 @@ void udp_server(const std::string& bind_address, int bind_port)
     while (true)
     {
         std::vector<uint8_t> buffer(1024);
-        std::string remote_address;
-        int remote_port = 0;
+        net::SocketAddr remote;
 
-        size_t received = server_socket.recv_from(buffer, remote_address, remote_port, ec);
+        size_t received = server_socket.recv_from(net::MutableBuffer(buffer), remote, ec);
         if (ec)
         {
             std::cerr << "Error receiving data: " << ec.message() << std::endl;
@@ -35,11 +34,11 @@ void udp_server(const std::string& bind_address, int bind_port)
         }
 
         std::string received_message(buffer.begin(), buffer.begin() + received);
-        std::cout << "Received " << received << " bytes from " << remote_address << ":" << remote_port
+        std::cout << "Received " << received << " bytes from " << remote.to_string()
             << " -> " << received_message << std::endl;
 
         // Echo the message back to the sender
-        size_t sent = server_socket.send_to(buffer, remote_address, remote_port, ec);
+        size_t sent = server_socket.send_to(net::ConstBuffer(buffer.data(), received), remote, ec);
         if (ec)
         {
             std::cerr << "Error sending response: " << ec.message() << std::endl;
@@ -0,0 +1,87 @@
+#ifndef AWAITABLE_H
+#define AWAITABLE_H
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <system_error>
+#include "IoContext.h"
+
+namespace net
+{
+    /// 由 IoContext 完成事件恢复的 co_await 操作基类
+    /// co_await 时派生类的 start() 提交请求并挂起协程，完成事件到达后在分发它的线程上恢复；
+    /// 提交失败时不挂起，错误写入构造时传入的 ec
+    template <typename Derived>
+    class IoAwaitable : public IoOperation
+    {
+    public:
+        explicit IoAwaitable(std::error_code& ec) : ec_(ec)
+        {
+            complete = &IoAwaitable::on_complete;
+        }
+
+        /// 请求提交后内核持有该对象的地址，不能拷贝或移动
+        IoAwaitable(const IoAwaitable&) = delete;
+        IoAwaitable& operator=(const IoAwaitable&) = delete;
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            handle_ = handle;
+            submitted_ = static_cast<Derived*>(this)->start(this, ec_);
+            return submitted_;
+        }
+
+    protected:
+        /// 供派生类的 await_resume 使用：请求失败时设置 ec 并返回 false
+        bool succeeded()
+        {
+            if (!submitted_)
+                return false;
+            if (result_ < 0)
+            {
+                ec_ = std::error_code(-result_, std::generic_category());
+                return false;
+            }
+            return true;
+        }
+
+        int result() const { return result_; }
+
+    private:
+        static void on_complete(IoOperation* op, int result, unsigned)
+        {
+            auto* self = static_cast<IoAwaitable*>(op);
+            self->result_ = result;
+            self->handle_.resume();
+        }
+
+        std::error_code& ec_;
+        std::coroutine_handle<> handle_;
+        int result_ = 0;
+        bool submitted_ = false;
+    };
+
+    /// 立即开始执行、结束后自行销毁的协程，不能被等待
+    /// 调用后在第一个 co_await 处返回，之后由当前线程的 IoContext::run() 驱动
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Task get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+} // namespace net
+
+#endif // __cpp_impl_coroutine
+
+#endif // AWAITABLE_H
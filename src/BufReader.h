@@ -0,0 +1,78 @@
+#ifndef BUF_READER_H
+#define BUF_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include "Buffer.h"
+#include "TcpStream.h"
+
+namespace net
+{
+    /// 带接收缓冲区的读取器：每次从连接读取尽量多的数据，再按分隔符或长度从缓冲区中切出
+    /// 返回的视图直接指向内部缓冲区，不拷贝数据，在下一次从连接读取之前有效
+    /// 分隔符查找从上次停下的位置继续，不会重复扫描已经检查过的字节
+    class BufReader
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+        /// stream 在 BufReader 使用期间必须保持有效
+        explicit BufReader(TcpStream& stream, size_t capacity = kDefaultCapacity);
+
+        /// 禁用拷贝构造和拷贝赋值
+        BufReader(const BufReader&) = delete;
+        BufReader& operator=(const BufReader&) = delete;
+
+        /// 已缓冲但尚未消费的数据
+        ConstBuffer buffered() const;
+
+        /// 缓冲区容量，也是 read_until 能返回的最长数据
+        size_t capacity() const { return capacity_; }
+
+        /// 对端已关闭连接且缓冲区中没有剩余数据
+        bool eof() const { return eof_ && begin_ == end_; }
+
+        /// 缓冲的数据少于 size 个字节时从连接读取，返回缓冲区开头最多 size 个字节，不消费
+        /// 连接关闭时返回的数据可能不足 size 个字节；size 超过容量时 ec 为 value_too_large
+        ConstBuffer peek(size_t size, std::error_code& ec);
+
+        /// 丢弃缓冲区开头的 size 个字节
+        void consume(size_t size);
+
+        /// 读取直到 delimiter（包含 delimiter）并消费这些数据
+        /// 对端在出现 delimiter 之前关闭连接时返回剩余的数据，没有剩余数据时返回空；
+        /// 容量内找不到 delimiter 时 ec 为 value_too_large，数据保留在缓冲区中
+        ConstBuffer read_until(uint8_t delimiter, std::error_code& ec);
+
+        /// 读取一行，返回的内容不含行尾的 "\n" 或 "\r\n"
+        /// 连接关闭且没有剩余数据时返回空，用 eof() 与空行区分
+        std::string_view read_line(std::error_code& ec);
+
+        /// 先取缓冲区中的数据；缓冲区为空时，buffer 不小于容量则直接读入 buffer，否则先填充缓冲区
+        size_t read(MutableBuffer buffer, std::error_code& ec);
+
+        /// 从连接读取一次，追加到缓冲区末尾，返回读到的字节数；缓冲区已满时 ec 为 value_too_large
+        size_t fill(std::error_code& ec);
+
+        /// 把容量扩大到至少 capacity，保留未消费的数据；之前返回的视图失效
+        void reserve(size_t capacity);
+
+    private:
+        void compact();
+
+        TcpStream& stream_;
+        std::unique_ptr<uint8_t[]> buffer_;
+        size_t capacity_;
+        size_t begin_ = 0;   ///< 未消费数据的起点
+        size_t end_ = 0;     ///< 已读入数据的终点
+        size_t scanned_ = 0; ///< [begin_, scanned_) 已确认不含当前查找的分隔符
+        uint8_t scan_delimiter_ = 0;
+        bool eof_ = false;
+    };
+
+} // namespace net
+
+#endif // BUF_READER_H
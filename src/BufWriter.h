@@ -0,0 +1,57 @@
+#ifndef BUF_WRITER_H
+#define BUF_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include "Buffer.h"
+#include "TcpStream.h"
+
+namespace net
+{
+    /// 带发送缓冲区的写入器：小块数据先聚集在缓冲区中，缓冲区满或显式调用 flush() 时才写出
+    /// 放不下的大块数据与已缓冲的数据一起用一次聚集写入发出，不再拷贝进缓冲区
+    class BufWriter
+    {
+    public:
+        static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+        /// stream 在 BufWriter 使用期间必须保持有效
+        explicit BufWriter(TcpStream& stream, size_t capacity = kDefaultCapacity);
+
+        /// 析构时写出剩余的数据，错误被忽略；需要知道结果时先调用 flush()
+        ~BufWriter();
+
+        /// 禁用拷贝构造和拷贝赋值
+        BufWriter(const BufWriter&) = delete;
+        BufWriter& operator=(const BufWriter&) = delete;
+
+        /// 追加 data，需要时写出缓冲区；成功时返回 data.size()
+        size_t write(ConstBuffer data, std::error_code& ec);
+
+        /// 在缓冲区中预留 size 个字节供调用者直接填写，之后用 commit() 确认实际写入的长度
+        /// 剩余空间不足时先写出缓冲区；size 超过容量时 ec 为 value_too_large
+        MutableBuffer prepare(size_t size, std::error_code& ec);
+
+        /// 确认 prepare() 预留的空间中前 size 个字节已经填写
+        void commit(size_t size);
+
+        /// 把缓冲的数据全部写出
+        bool flush(std::error_code& ec);
+
+        /// 已缓冲尚未写出的字节数
+        size_t buffered() const { return size_; }
+
+        size_t capacity() const { return capacity_; }
+
+    private:
+        TcpStream& stream_;
+        std::unique_ptr<uint8_t[]> buffer_;
+        size_t capacity_;
+        size_t size_ = 0;
+    };
+
+} // namespace net
+
+#endif // BUF_WRITER_H
@@ -0,0 +1,54 @@
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace net
+{
+    /// 只读的非拥有缓冲区视图，调用期间由调用者保证内存有效
+    class ConstBuffer
+    {
+    public:
+        ConstBuffer() : data_(nullptr), size_(0) {}
+        ConstBuffer(const void* data, size_t size) : data_(static_cast<const uint8_t*>(data)), size_(size) {}
+        ConstBuffer(const std::vector<uint8_t>& bytes) : data_(bytes.data()), size_(bytes.size()) {}
+        ConstBuffer(const std::string& text) : ConstBuffer(text.data(), text.size()) {}
+        ConstBuffer(std::string_view text) : ConstBuffer(text.data(), text.size()) {}
+
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+
+        /// 跳过前 n 个字节后的剩余部分
+        ConstBuffer advance(size_t n) const { return n >= size_ ? ConstBuffer() : ConstBuffer(data_ + n, size_ - n); }
+
+    private:
+        const uint8_t* data_;
+        size_t size_;
+    };
+
+    /// 可写的非拥有缓冲区视图，调用期间由调用者保证内存有效
+    class MutableBuffer
+    {
+    public:
+        MutableBuffer() : data_(nullptr), size_(0) {}
+        MutableBuffer(void* data, size_t size) : data_(static_cast<uint8_t*>(data)), size_(size) {}
+        MutableBuffer(std::vector<uint8_t>& bytes) : data_(bytes.data()), size_(bytes.size()) {}
+
+        uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+
+        /// 跳过前 n 个字节后的剩余部分
+        MutableBuffer advance(size_t n) const { return n >= size_ ? MutableBuffer() : MutableBuffer(data_ + n, size_ - n); }
+
+    private:
+        uint8_t* data_;
+        size_t size_;
+    };
+
+} // namespace net
+
+#endif // BUFFER_H
@@ -0,0 +1,81 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+
+namespace net
+{
+    class FixedBuffer;
+
+    /// 注册到 io_uring 的固定缓冲区池：一整块内存一次性注册给内核，
+    /// 按固定大小切片借出，读写时内核不再逐次固定和释放页面
+    /// 每个线程的 IoContext 只能注册一个缓冲区池，且只能在该线程上使用和销毁
+    class BufferPool
+    {
+    public:
+        BufferPool();
+        ~BufferPool();
+
+        /// 禁用拷贝构造和拷贝赋值
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /// 移动构造和移动赋值
+        BufferPool(BufferPool&& other) noexcept;
+        BufferPool& operator=(BufferPool&& other) noexcept;
+
+        /// 创建 slice_count 个大小为 slice_size 的切片并注册到当前线程的 io_uring
+        static std::optional<BufferPool> create(size_t slice_size, unsigned slice_count, std::error_code& ec);
+
+        /// 借出一个切片，池已耗尽时返回无效的 FixedBuffer
+        FixedBuffer acquire();
+
+        /// 单个切片的大小
+        size_t slice_size() const;
+
+        /// 当前可借出的切片数量
+        unsigned available() const;
+
+    public:
+        class Impl; // 平台特定实现
+        Impl* impl_;
+    };
+
+    /// 从 BufferPool 借出的切片，release() 或析构时归还
+    /// 借出的切片必须先于所属的 BufferPool 释放
+    class FixedBuffer
+    {
+    public:
+        FixedBuffer();
+        FixedBuffer(BufferPool::Impl* pool, unsigned index, uint8_t* data, size_t capacity);
+        ~FixedBuffer();
+
+        /// 禁用拷贝构造和拷贝赋值
+        FixedBuffer(const FixedBuffer&) = delete;
+        FixedBuffer& operator=(const FixedBuffer&) = delete;
+
+        /// 移动构造和移动赋值
+        FixedBuffer(FixedBuffer&& other) noexcept;
+        FixedBuffer& operator=(FixedBuffer&& other) noexcept;
+
+        uint8_t* data() const { return data_; }
+        size_t capacity() const { return capacity_; }
+        BufferPool::Impl* pool() const { return pool_; }
+        explicit operator bool() const { return data_ != nullptr; }
+
+        /// 提前把切片归还给缓冲区池
+        void release();
+
+    private:
+        BufferPool::Impl* pool_;
+        unsigned index_;
+        uint8_t* data_;
+        size_t capacity_;
+    };
+
+} // namespace net
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,75 @@
+#ifndef BUFFER_RING_H
+#define BUFFER_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+
+namespace net
+{
+    /// 由内核挑选的共享接收缓冲区池（io_uring provided buffer ring）
+    /// 读操作只在数据到达时才占用缓冲区，空闲连接不再各自持有缓冲区
+    /// 缓冲区池注册在创建它的线程的 IoContext 上，只能在该线程上使用和销毁
+    class BufferRing
+    {
+    public:
+        BufferRing();
+        ~BufferRing();
+
+        /// 禁用拷贝构造和拷贝赋值
+        BufferRing(const BufferRing&) = delete;
+        BufferRing& operator=(const BufferRing&) = delete;
+
+        /// 移动构造和移动赋值
+        BufferRing(BufferRing&& other) noexcept;
+        BufferRing& operator=(BufferRing&& other) noexcept;
+
+        /// 创建 count 个大小为 buffer_size 的缓冲区，count 必须是 2 的幂且不超过 32768
+        static std::optional<BufferRing> create(unsigned count, size_t buffer_size, std::error_code& ec);
+
+        /// 单个缓冲区的大小
+        size_t buffer_size() const;
+
+        /// 缓冲区数量
+        unsigned count() const;
+
+    public:
+        class Impl; // 平台特定实现
+        Impl* impl_;
+    };
+
+    /// 从 BufferRing 借出的缓冲区，release() 或析构时归还给内核
+    /// 借出的缓冲区必须先于所属的 BufferRing 释放
+    class ProvidedBuffer
+    {
+    public:
+        ProvidedBuffer();
+        ProvidedBuffer(BufferRing::Impl* ring, uint16_t id, const uint8_t* data, size_t size);
+        ~ProvidedBuffer();
+
+        /// 禁用拷贝构造和拷贝赋值
+        ProvidedBuffer(const ProvidedBuffer&) = delete;
+        ProvidedBuffer& operator=(const ProvidedBuffer&) = delete;
+
+        /// 移动构造和移动赋值
+        ProvidedBuffer(ProvidedBuffer&& other) noexcept;
+        ProvidedBuffer& operator=(ProvidedBuffer&& other) noexcept;
+
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /// 提前把缓冲区归还给内核
+        void release();
+
+    private:
+        BufferRing::Impl* ring_;
+        uint16_t id_;
+        const uint8_t* data_;
+        size_t size_;
+    };
+
+} // namespace net
+
+#endif // BUFFER_RING_H
@@ -0,0 +1,95 @@
+#ifndef COMPLETION_HANDLER_H
+#define COMPLETION_HANDLER_H
+
+#include <cstddef>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "IoContext.h"
+
+namespace net
+{
+    /// 回调接口使用的操作对象：从当前线程的池中取出，提交时作为 io_uring 的 user_data，
+    /// 完成后先归还到池中再调用回调，回调里发起的下一个操作可以复用同一个对象
+    /// 不超过 kInlineSize 的回调直接保存在对象内部，不做单独的堆分配
+    class HandlerOperation : public IoOperation
+    {
+    public:
+        static constexpr size_t kInlineSize = 64;
+
+        /// 分配一个操作对象并保存 function，完成时以原始结果调用 function(int)
+        template <typename Function>
+        static HandlerOperation* create(Function function)
+        {
+            HandlerOperation* op = allocate();
+            if constexpr (fits_inline<Function>)
+                op->function_ = new (op->storage_) Function(std::move(function));
+            else
+                op->function_ = new Function(std::move(function));
+            op->invoke_ = &HandlerOperation::invoke<Function>;
+            op->error_ = 0;
+            return op;
+        }
+
+        /// 取得保存的回调对象，用于在提交前访问它持有的状态
+        template <typename Function>
+        Function& function()
+        {
+            return *static_cast<Function*>(function_);
+        }
+
+        /// 提交失败时调用：通过事件循环以 error 调用回调，避免在发起调用的栈上重入
+        void fail(const std::error_code& error);
+
+    private:
+        HandlerOperation() = default;
+
+        template <typename Function>
+        static constexpr bool fits_inline =
+            sizeof(Function) <= kInlineSize && alignof(Function) <= alignof(std::max_align_t);
+
+        static HandlerOperation* allocate();
+        static void deallocate(HandlerOperation* op);
+        static void on_complete(IoOperation* op, int result, unsigned flags);
+
+        // 先把回调移出并归还操作对象，再调用回调
+        template <typename Function>
+        static void invoke(HandlerOperation* op, int result)
+        {
+            auto* stored = static_cast<Function*>(op->function_);
+            Function function(std::move(*stored));
+            if constexpr (fits_inline<Function>)
+                stored->~Function();
+            else
+                delete stored;
+            deallocate(op);
+            function(result);
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+        void* function_ = nullptr;
+        void (*invoke_)(HandlerOperation* op, int result) = nullptr;
+        int error_ = 0; ///< 非 0 时代替完成事件的结果
+    };
+
+    /// 把 handler(size_t, std::error_code) 包装为接收原始完成结果的回调
+    template <typename Handler>
+    auto transfer_handler(Handler handler)
+    {
+        return [handler = std::move(handler)](int result) mutable
+        {
+            if (result < 0)
+                handler(size_t(0), std::error_code(-result, std::generic_category()));
+            else
+                handler(static_cast<size_t>(result), std::error_code());
+        };
+    }
+
+    template <typename Handler>
+    using enable_if_transfer_handler_t =
+        std::enable_if_t<std::is_invocable_v<Handler&, size_t, std::error_code>, int>;
+
+} // namespace net
+
+#endif // COMPLETION_HANDLER_H
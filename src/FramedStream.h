@@ -0,0 +1,94 @@
+#ifndef FRAMED_STREAM_H
+#define FRAMED_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+#include "Buffer.h"
+#include "BufReader.h"
+#include "BufWriter.h"
+#include "TcpStream.h"
+
+namespace net
+{
+    /// 帧头中长度字段的编码，长度只计负载，不含帧头和校验和
+    enum class LengthPrefix : uint8_t
+    {
+        U16,    ///< 2 字节大端序
+        U32,    ///< 4 字节大端序
+        Varint  ///< LEB128 变长整数（与 protobuf 相同），1 到 5 字节
+    };
+
+    /// 分帧选项，收发双方必须一致
+    struct FrameOptions
+    {
+        LengthPrefix prefix = LengthPrefix::U32;
+        bool crc32c = false;                    ///< 负载之后附加 4 字节小端序的 CRC32C 校验和
+        size_t max_frame_size = 16 * 1024 * 1024; ///< 超过该长度的帧视为错误
+        size_t read_buffer_size = 256 * 1024;   ///< 接收缓冲区的初始容量，帧头声明更大的帧时才按需扩大
+        size_t write_buffer_size = 64 * 1024;   ///< 发送缓冲区容量，小帧在其中打包后一次写出
+    };
+
+    /// 长度前缀分帧：一次大块读取带回的所有完整帧都在这一次调用中解码，
+    /// 返回的帧是指向接收缓冲区的视图，不拷贝负载；发送的帧先打包在发送缓冲区中，满了或 flush() 时一次写出
+    class FramedStream
+    {
+    public:
+        /// stream 在 FramedStream 使用期间必须保持有效
+        explicit FramedStream(TcpStream& stream, const FrameOptions& options = FrameOptions());
+
+        /// 禁用拷贝构造和拷贝赋值
+        FramedStream(const FramedStream&) = delete;
+        FramedStream& operator=(const FramedStream&) = delete;
+
+        /// 缓冲区中没有完整的帧时从连接读取，然后把缓冲区中所有完整的帧追加到 frames，返回追加的数量
+        /// 视图在下一次读取之前有效；连接正常关闭时返回 0 且不设置 ec
+        /// 帧超过 max_frame_size 时 ec 为 message_size，校验和不符时为 bad_message，
+        /// 连接在帧中途关闭时为 connection_reset；出错的帧之前已解码的帧先正常返回，错误在下一次调用时报告
+        size_t read_frames(std::vector<ConstBuffer>& frames, std::error_code& ec);
+
+        /// 读取一个帧，视图在下一次读取之前有效；连接正常关闭时返回空视图，用 eof() 与空帧区分
+        ConstBuffer read_frame(std::error_code& ec);
+
+        /// 对端已关闭连接且没有剩余数据
+        bool eof() const { return reader_.eof(); }
+
+        /// 编码一个帧放入发送缓冲区，缓冲区放不下时先写出；大于缓冲区的负载不拷贝，与缓冲的数据一起写出
+        bool write_frame(ConstBuffer payload, std::error_code& ec);
+
+        /// 写出所有已打包的帧
+        bool flush(std::error_code& ec);
+
+        /// 长度字段的最大字节数
+        static constexpr size_t kMaxHeaderSize = 5;
+
+        /// 校验和的字节数
+        static constexpr size_t kChecksumSize = 4;
+
+    private:
+        enum class Decode
+        {
+            Frame,
+            Incomplete,
+            Error
+        };
+
+        // 从 data 的 offset 处解码一个帧，成功时推进 offset
+        // 帧头完整但数据不足时 needed 为整个帧的字节数，否则为 0
+        Decode decode(ConstBuffer data, size_t& offset, ConstBuffer& frame, size_t& needed, std::error_code& ec) const;
+
+        // 把长度编码到 header，返回使用的字节数
+        size_t encode_length(size_t length, uint8_t* header) const;
+
+        // 缓冲区放不下 needed 字节的帧时先扩大，再从连接读取一次，连接关闭或出错时返回 false
+        bool fill(size_t needed, std::error_code& ec);
+
+        FrameOptions options_;
+        BufReader reader_;
+        BufWriter writer_;
+    };
+
+} // namespace net
+
+#endif // FRAMED_STREAM_H
@@ -0,0 +1,88 @@
+#ifndef IO_CONTEXT_H
+#define IO_CONTEXT_H
+
+#include <chrono>
+#include <cstddef>
+#include <system_error>
+
+namespace net
+{
+    /// 异步操作的基础结构：提交时 io_uring 的 user_data 指向它，
+    /// 完成事件按 user_data 分发到 complete 回调
+    struct IoOperation
+    {
+        void (*complete)(IoOperation *op, int result, unsigned flags) = nullptr;
+    };
+
+    /// io_uring 实例的创建参数，在线程第一次使用 IoContext 之前通过 IoContext::configure 设置
+    /// 同一线程上的监听者、连接、套接字和事件循环共享这个实例，因而共享这些参数
+    struct RingConfig
+    {
+        unsigned queue_depth = 256;   ///< 提交队列大小
+        unsigned cq_entries = 0;      ///< 完成队列大小（IORING_SETUP_CQSIZE），0 表示内核默认的两倍 queue_depth
+
+        /// IORING_SETUP_SQPOLL：由内核线程轮询提交队列，热路径上的提交不需要系统调用
+        bool sqpoll = false;
+        unsigned sq_thread_idle = 0;  ///< 轮询线程空闲多少毫秒后休眠，0 表示内核默认
+        int sq_thread_cpu = -1;       ///< 轮询线程绑定的 CPU（IORING_SETUP_SQ_AFF），-1 表示不绑定
+
+        /// IORING_SETUP_SINGLE_ISSUER：只有创建实例的线程提交请求，内核省去相应的同步
+        bool single_issuer = false;
+
+        /// IORING_SETUP_DEFER_TASKRUN：完成处理推迟到线程等待完成事件时批量执行，隐含 single_issuer，不能与 sqpoll 同时使用
+        bool defer_taskrun = false;
+
+        /// IORING_SETUP_COOP_TASKRUN：完成处理不再用处理器间中断打断正在运行的线程
+        bool coop_taskrun = false;
+    };
+
+    /// 事件循环：每个线程拥有一个 io_uring，线程内的所有套接字共享它
+    class IoContext
+    {
+    public:
+        ~IoContext();
+
+        /// 禁用拷贝构造和拷贝赋值
+        IoContext(const IoContext&) = delete;
+        IoContext& operator=(const IoContext&) = delete;
+
+        /// 获取当前线程的 IoContext，首次使用时创建
+        static IoContext& current();
+
+        /// 设置当前线程 io_uring 的创建参数，必须在该线程第一次提交请求之前调用，
+        /// 否则 ec 为 device_or_resource_busy；不支持的参数在创建时由内核报告
+        bool configure(const RingConfig& config, std::error_code& ec);
+
+        /// 提交挂起的请求，等待至少一个完成事件并分发所有已就绪的事件
+        size_t run_once(std::error_code& ec);
+
+        /// 提交挂起的请求并分发已就绪的完成事件，不阻塞
+        size_t poll(std::error_code& ec);
+
+        /// 循环分发完成事件，直到没有未完成的操作或调用了 stop()
+        size_t run(std::error_code& ec);
+
+        /// 让 run() 在当前完成事件分发后返回
+        void stop();
+
+        /// 在下一次分发完成事件时以结果 0 调用 op->complete，用于把回调推迟到事件循环中执行
+        bool post(IoOperation* op, std::error_code& ec);
+
+        /// timeout 后以结果 -ETIME 调用 op->complete，可用于按固定节拍推进 TimerWheel
+        bool start_timer(std::chrono::nanoseconds timeout, IoOperation* op, std::error_code& ec);
+
+        /// 注册一张包含 count 个槽位的固定文件表
+        /// 不调用时，第一个注册为固定文件的套接字会按默认大小创建
+        bool enable_fixed_files(unsigned count, std::error_code& ec);
+
+    public:
+        class Impl; // 平台特定实现
+        Impl* impl_;
+
+    private:
+        IoContext();
+    };
+
+} // namespace net
+
+#endif // IO_CONTEXT_H
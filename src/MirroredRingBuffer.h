@@ -0,0 +1,71 @@
+#ifndef MIRRORED_RING_BUFFER_H
+#define MIRRORED_RING_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include "Buffer.h"
+#include "TcpStream.h"
+
+namespace net
+{
+    /// 双重映射的环形缓冲区：同一段物理页在虚拟地址上连续映射两次，
+    /// 越过末尾的访问落到第二份映射上，等同于回到开头
+    /// 因此可读数据和空闲空间始终是连续的一整块，可以直接交给解析器或作为读取的目标，不需要拷贝拼接
+    /// 容量向上取整到页大小（Windows 为分配粒度）
+    class MirroredRingBuffer
+    {
+    public:
+        MirroredRingBuffer();
+        ~MirroredRingBuffer();
+
+        /// 禁用拷贝构造和拷贝赋值
+        MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+        MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+
+        /// 移动构造和移动赋值
+        MirroredRingBuffer(MirroredRingBuffer&& other) noexcept;
+        MirroredRingBuffer& operator=(MirroredRingBuffer&& other) noexcept;
+
+        /// 创建容量不小于 capacity 的缓冲区
+        static std::optional<MirroredRingBuffer> create(size_t capacity, std::error_code& ec);
+
+        /// 全部可读数据，连续的一整块
+        ConstBuffer readable() const { return ConstBuffer(data_ + head_, size_); }
+
+        /// 全部空闲空间，连续的一整块；可直接传给 TcpStream::read、start_read 等
+        MutableBuffer writable() const { return MutableBuffer(data_ + head_ + size_, capacity_ - size_); }
+
+        /// 确认 writable() 的前 size 个字节已经写入
+        void commit(size_t size);
+
+        /// 丢弃 readable() 开头的 size 个字节
+        void consume(size_t size);
+
+        /// 丢弃全部数据
+        void clear();
+
+        /// 从连接读取一次追加到可读数据末尾，返回读到的字节数，连接关闭时返回 0
+        /// 缓冲区已满时 ec 为 value_too_large
+        size_t fill(TcpStream& stream, std::error_code& ec);
+
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+        bool full() const { return size_ == capacity_; }
+
+    public:
+        class Impl; // 平台特定实现
+        Impl* impl_;
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t capacity_ = 0;
+        size_t head_ = 0; ///< 可读数据的起点，始终小于 capacity_
+        size_t size_ = 0;
+    };
+
+} // namespace net
+
+#endif // MIRRORED_RING_BUFFER_H
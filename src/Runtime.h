@@ -0,0 +1,66 @@
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+#include <functional>
+#include <string>
+#include <system_error>
+#include "TcpListener.h"
+
+namespace net
+{
+    /// 运行时选项
+    struct RuntimeOptions
+    {
+        unsigned workers = 0;    ///< 工作线程数，0 表示使用进程可用的 CPU 数
+        bool pin_workers = true; ///< 把第 i 个工作线程固定到进程可用的第 i 个 CPU 上
+        RingConfig ring;         ///< 每个工作线程的 io_uring 的创建参数
+    };
+
+    /// 每核一线程的运行时：每个工作线程固定在一个 CPU 上并驱动自己的 IoContext，
+    /// 线程之间不共享 io_uring，也不转交连接
+    class Runtime
+    {
+    public:
+        Runtime();
+
+        /// 停止并等待所有工作线程
+        ~Runtime();
+
+        /// 禁用拷贝构造和拷贝赋值
+        Runtime(const Runtime&) = delete;
+        Runtime& operator=(const Runtime&) = delete;
+
+        /// 移动构造和移动赋值
+        Runtime(Runtime&& other) noexcept;
+        Runtime& operator=(Runtime&& other) noexcept;
+
+        /// 启动工作线程：在每个线程上调用 worker(index) 发起异步操作，
+        /// 之后该线程驱动自己的 IoContext 直到 stop()
+        /// 所有工作线程都完成 CPU 固定和 io_uring 创建后才返回；任何一个失败时
+        /// 不在任何线程上调用 worker，等待全部线程退出后返回 false
+        bool start(const RuntimeOptions& options, std::function<void(unsigned worker)> worker, std::error_code& ec);
+
+        /// 为每个工作线程绑定一个 SO_REUSEPORT 监听者，内核按连接的哈希在它们之间分配新连接，
+        /// 没有共享的 accept 锁；所有监听者在调用线程上绑定成功后才启动工作线程
+        /// worker(listener, index) 在对应的线程上调用，监听者在该线程退出前保持有效
+        bool serve(const std::string& address, int port, const RuntimeOptions& options,
+                   std::function<void(TcpListener& listener, unsigned worker)> worker, std::error_code& ec);
+
+        /// 通知所有工作线程退出事件循环，可以在任意线程上调用
+        /// 正在执行阻塞调用的线程要等该调用返回后才会退出
+        void stop();
+
+        /// 等待所有工作线程退出，不能在工作线程上调用
+        void join();
+
+        /// 工作线程数
+        unsigned size() const;
+
+    private:
+        class Impl; // 平台特定实现
+        Impl* impl_;
+    };
+
+} // namespace net
+
+#endif // RUNTIME_H
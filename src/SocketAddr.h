@@ -0,0 +1,75 @@
+#ifndef SOCKET_ADDR_H
+#define SOCKET_ADDR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+struct sockaddr;
+struct sockaddr_storage;
+
+namespace net
+{
+    /// 预先解析好的二进制套接字地址（IPv4 或 IPv6），可平凡拷贝
+    /// 在热路径上代替字符串地址，避免每个数据包都做 inet_pton / inet_ntop
+    class SocketAddr
+    {
+    public:
+        enum class Family : uint8_t
+        {
+            None,
+            V4,
+            V6
+        };
+
+        SocketAddr() = default;
+
+        /// 解析文本地址，支持 IPv4 点分十进制和 IPv6 冒号十六进制
+        static std::optional<SocketAddr> parse(const std::string& address, int port);
+
+        /// 从 sockaddr_in / sockaddr_in6 构造，地址族不支持时返回空地址
+        static SocketAddr from_sockaddr(const sockaddr* addr, size_t length);
+
+        /// 写入 sockaddr_in / sockaddr_in6，返回地址长度，空地址返回 0
+        size_t to_sockaddr(sockaddr_storage& storage) const;
+
+        Family family() const { return family_; }
+        uint16_t port() const { return port_; }
+        bool empty() const { return family_ == Family::None; }
+
+        /// 网络字节序的地址，IPv4 占前 4 个字节
+        const uint8_t* bytes() const { return bytes_; }
+
+        /// 地址部分的文本形式
+        std::string address() const;
+
+        /// "1.2.3.4:80" 或 "[::1]:80"
+        std::string to_string() const;
+
+        size_t hash() const;
+
+        bool operator==(const SocketAddr& other) const;
+        bool operator!=(const SocketAddr& other) const { return !(*this == other); }
+        bool operator<(const SocketAddr& other) const;
+
+    private:
+        uint8_t bytes_[16] = {};
+        uint32_t scope_id_ = 0;
+        uint16_t port_ = 0;
+        Family family_ = Family::None;
+    };
+
+} // namespace net
+
+namespace std
+{
+    template <>
+    struct hash<net::SocketAddr>
+    {
+        size_t operator()(const net::SocketAddr& addr) const { return addr.hash(); }
+    };
+}
+
+#endif // SOCKET_ADDR_H
@@ -0,0 +1,102 @@
+#ifndef SUBMIT_BATCH_H
+#define SUBMIT_BATCH_H
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <system_error>
+#include "Buffer.h"
+#include "IoContext.h"
+#include "SocketAddr.h"
+#include "TcpStream.h"
+#include "UdpSocket.h"
+
+namespace net
+{
+    /// 批量提交：先在多个连接上准备请求，这期间只写入提交队列、不进入内核，
+    /// flush() 再用一次 io_uring_submit_and_wait 提交全部请求并等待它们完成
+    /// 批中引用的连接和缓冲区在 flush() 返回前必须保持有效，目标地址由批保存；
+    /// 析构时会 flush 尚未完成的请求，事件循环出错时取消它们并等待其结束
+    /// 只能在创建它的线程上使用
+    class SubmitBatch
+    {
+    public:
+        /// 单个请求的结果
+        struct Result
+        {
+            size_t bytes = 0;     ///< 请求成功时的非负结果，读写请求为传输的字节数
+            std::error_code error; ///< 准备或执行请求时的错误
+        };
+
+        SubmitBatch();
+        ~SubmitBatch();
+
+        /// 请求提交后内核持有其中操作对象的地址，不能拷贝或移动
+        SubmitBatch(const SubmitBatch&) = delete;
+        SubmitBatch& operator=(const SubmitBatch&) = delete;
+
+        /// 准备一个读取或写入请求，返回它在批中的序号，flush() 之后用 result() 取结果
+        size_t read(TcpStream& stream, MutableBuffer buffer);
+        size_t write(TcpStream& stream, ConstBuffer data);
+
+        /// 准备一个连接请求，stream 必须尚未连接，连接成功时结果为 0
+        size_t connect(TcpStream& stream, const SocketAddr& address);
+
+        /// 准备一个发送数据报的请求，结果为发送的字节数
+        size_t send_to(UdpSocket& socket, ConstBuffer data, const SocketAddr& destination);
+
+        /// 准备任意单次完成的提交原语：start(IoOperation* op, std::error_code& ec) 只准备请求，成功时返回 true
+        /// 例如 [&](IoOperation* op, std::error_code& ec) { return socket.start_recv_from(buffer, source, op, ec); }
+        template <typename Start>
+        size_t add(Start start)
+        {
+            return prepare(next_entry(), start);
+        }
+
+        /// 提交全部请求并等待它们完成；ec 只报告事件循环本身的错误，单个请求的错误见 result()
+        bool flush(std::error_code& ec);
+
+        /// 第 index 个请求的结果，flush() 之前可能尚未完成
+        const Result& result(size_t index) const { return entries_[index].result; }
+
+        /// 批中的请求数量
+        size_t size() const { return entries_.size(); }
+
+        /// 清空已完成的请求以便复用；仍有未完成的请求时先 flush
+        void clear();
+
+    private:
+        struct Entry : IoOperation
+        {
+            SubmitBatch* batch = nullptr;
+            Result result;
+            std::unique_ptr<sockaddr_storage> address; ///< 连接和发送请求的目标地址，请求完成前保持有效
+            bool in_flight = false;
+        };
+
+        template <typename Start>
+        size_t prepare(Entry& entry, Start& start)
+        {
+            std::error_code ec;
+            if (start(static_cast<IoOperation*>(&entry), ec))
+            {
+                entry.in_flight = true;
+                ++pending_;
+            }
+            else
+                entry.result.error = ec;
+            return entries_.size() - 1;
+        }
+
+        Entry& next_entry();
+        sockaddr_storage& address_of(Entry& entry);
+        static void on_complete(IoOperation* op, int result, unsigned flags);
+
+        std::deque<Entry> entries_; ///< deque 追加时不移动已有元素，已提交的操作对象地址保持不变
+        size_t pending_ = 0;
+        IoContext& context_;
+    };
+
+} // namespace net
+
+#endif // SUBMIT_BATCH_H
@@ -1,13 +1,24 @@
 #ifndef TCP_LISTENER_H
 #define TCP_LISTENER_H
 
+#include <chrono>
 #include <string>
 #include <optional>
 #include <memory>
+#include <vector>
 #include "TcpStream.h" // TcpStream 的定义包含通信逻辑
+#include "SocketAddr.h"
+#include "Awaitable.h"
 
 namespace net
 {
+    /// 监听选项
+    struct ListenOptions
+    {
+        /// 设置 SO_REUSEPORT：多个监听者可以绑定同一地址和端口，由内核按连接的哈希分配新连接
+        bool reuse_port = false;
+    };
+
     class TcpListener
     {
     public:
@@ -22,12 +33,57 @@ namespace net
         TcpListener(TcpListener&& other) noexcept;
         TcpListener& operator=(TcpListener&& other) noexcept;
 
-        /// 绑定一个地址和端口并返回一个 TcpListener 实例
+        /// 绑定一个地址和端口并返回一个 TcpListener 实例，监听套接字的地址族跟随 address
+        /// Windows 上只支持 IPv4，IPv6 地址返回 address_family_not_supported
         static std::optional<TcpListener> bind(const std::string& address, int port, std::error_code& ec);
+        static std::optional<TcpListener> bind(const std::string& address, int port, const ListenOptions& options, std::error_code& ec);
 
         /// 接受一个新的连接
         std::optional<TcpStream> accept(std::error_code& ec);
 
+        /// 接受一个新的连接，peer 返回对端地址
+        std::optional<TcpStream> accept(SocketAddr& peer, std::error_code& ec);
+
+        /// 直接 accept：新连接放入当前线程 io_uring 的固定文件表，不占用普通文件描述符
+        /// 返回的 TcpStream 只能在当前线程上使用
+        std::optional<TcpStream> accept_direct(std::error_code& ec);
+
+        /// 批量接受连接，追加最多 max 个到 streams，返回追加的数量
+        /// Linux 下首次调用会启用 multishot accept，之后 accept() 也从同一队列取连接，监听者必须在该线程上销毁
+        size_t accept_batch(std::vector<TcpStream>& streams, size_t max, std::error_code& ec);
+
+        /// accept、accept_direct 和 accept_batch 的等待期限，超时时 ec 为 timed_out，0 表示一直等待（默认）
+        void set_accept_timeout(std::chrono::milliseconds timeout);
+
+        /// 异步 accept 的提交原语：完成时 op->complete 收到新连接的描述符或负的错误码
+        /// 与 accept_batch 的 multishot 队列互不相干，不要在同一个监听者上混用
+        bool start_accept(IoOperation* op, std::error_code& ec);
+
+        /// 回调接口：完成时在当前线程的 IoContext 上调用
+        /// handler(std::optional<TcpStream> stream, std::error_code ec)
+        template <typename Handler,
+                  std::enable_if_t<std::is_invocable_v<Handler&, std::optional<TcpStream>, std::error_code>, int> = 0>
+        void async_accept(Handler handler)
+        {
+            HandlerOperation* op = HandlerOperation::create([handler = std::move(handler)](int result) mutable
+            {
+                if (result < 0)
+                    handler(std::nullopt, std::error_code(-result, std::generic_category()));
+                else
+                    handler(TcpStream(result), std::error_code());
+            });
+            std::error_code ec;
+            if (!start_accept(op, ec))
+                op->fail(ec);
+        }
+
+#if defined(__cpp_impl_coroutine)
+        class AcceptAwaitable;
+
+        /// 协程接口：co_await 得到新连接，失败时为空并设置 ec
+        AcceptAwaitable async_accept(std::error_code& ec);
+#endif
+
     private:
         // 内部实现类，隐藏平台特定逻辑
 
@@ -35,6 +91,32 @@ namespace net
         Impl* impl_;
     };
 
+#if defined(__cpp_impl_coroutine)
+    class TcpListener::AcceptAwaitable : public IoAwaitable<TcpListener::AcceptAwaitable>
+    {
+    public:
+        AcceptAwaitable(TcpListener& listener, std::error_code& ec)
+            : IoAwaitable(ec), listener_(listener) {}
+
+        bool start(IoOperation* op, std::error_code& ec) { return listener_.start_accept(op, ec); }
+
+        std::optional<TcpStream> await_resume()
+        {
+            if (!succeeded())
+                return std::nullopt;
+            return TcpStream(result());
+        }
+
+    private:
+        TcpListener& listener_;
+    };
+
+    inline TcpListener::AcceptAwaitable TcpListener::async_accept(std::error_code& ec)
+    {
+        return AcceptAwaitable(*this, ec);
+    }
+#endif
+
 } // namespace net
 
 #endif // TCP_LISTENER_H
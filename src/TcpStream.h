@@ -1,13 +1,20 @@
 #ifndef TCP_STREAM_H
 #define TCP_STREAM_H
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <optional>
 #include <system_error>
+#include "Buffer.h"
+#include "BufferPool.h"
+#include "BufferRing.h"
+#include "IoContext.h"
+#include "SocketAddr.h"
+#include "Awaitable.h"
+#include "CompletionHandler.h"
 
 class SOCKET;
-class io_uring;
 
 namespace net
 {
@@ -18,7 +25,7 @@ namespace net
         // 构造函数和析构函数
         TcpStream();
         TcpStream(SOCKET socket);
-        TcpStream(int socket_fd, io_uring *ring);
+        TcpStream(int socket_fd);
         ~TcpStream();
 
         // 禁用拷贝构造和赋值
@@ -32,17 +39,222 @@ namespace net
         // 连接到远程地址
         static std::optional<TcpStream> connect(const std::string& address, int port, std::error_code& ec);
 
+        // 连接到远程地址，timeout 内没有建立连接时返回空并设置 ec 为 timed_out
+        static std::optional<TcpStream> connect(const std::string& address, int port, std::chrono::milliseconds timeout, std::error_code& ec);
+
+        // 把连接注册到当前线程 io_uring 的固定文件表，该线程上的后续操作不再查找文件表
+        // 注册后连接必须在该线程上销毁
+        bool register_fixed(std::error_code& ec);
+
         // 写入数据
         size_t write(const std::vector<uint8_t>& data, std::error_code& ec);
 
+        // 写入 data 指向的数据，可能只写入一部分
+        size_t write(ConstBuffer data, std::error_code& ec);
+
+        // 循环写入直到 data 全部写完或出错，返回已写入的字节数
+        size_t write_all(ConstBuffer data, std::error_code& ec);
+
+        // 零拷贝写入（Linux 下使用 IORING_OP_SEND_ZC），返回时内核已不再引用 data
+        size_t write_zero_copy(const std::vector<uint8_t>& data, std::error_code& ec);
+
+        // 把文件 file_fd 中从 offset 开始的 length 个字节发送到连接，数据不经过用户空间
+        // Linux 下分块用链接的 IORING_OP_SPLICE 经管道转发，文件不支持 splice 时改用 sendfile
+        // 返回已发送的字节数，文件在 length 之前结束时少于 length 且不设置 ec；不改变文件的读写位置
+        size_t send_file(int file_fd, uint64_t offset, size_t length, std::error_code& ec);
+
+        // 设置 write() 自动改用零拷贝写入的数据大小阈值，0 表示关闭（默认）
+        void set_zero_copy_threshold(size_t bytes);
+
+        // 阻塞读取/写入的期限：超过 timeout 仍未完成的操作被取消并设置 ec 为 timed_out，0 表示一直等待（默认）
+        // Linux 下每个请求与一个 IORING_OP_LINK_TIMEOUT 在同一次系统调用中提交；异步接口不受影响
+        void set_read_timeout(std::chrono::milliseconds timeout);
+        void set_write_timeout(std::chrono::milliseconds timeout);
+
+        // 聚集写入：把 count 个缓冲区按顺序作为一次写操作提交，可能只写入一部分
+        size_t writev(const ConstBuffer* buffers, size_t count, std::error_code& ec);
+
         // 读取数据
         size_t read(std::vector<uint8_t>& buffer, std::error_code& ec);
 
+        // 读取数据到 buffer 指向的内存，可能只读取一部分
+        size_t read(MutableBuffer buffer, std::error_code& ec);
+
+        // 循环读取直到 buffer 被填满或出错，对端提前关闭时 ec 为 connection_reset
+        size_t read_exact(MutableBuffer buffer, std::error_code& ec);
+
+        // 使用缓冲区池中的固定缓冲区写入前 size 个字节（Linux 下为 IORING_OP_WRITE_FIXED）
+        size_t write_fixed(const FixedBuffer& buffer, size_t size, std::error_code& ec);
+
+        // 读取数据到缓冲区池中的固定缓冲区（Linux 下为 IORING_OP_READ_FIXED）
+        size_t read_fixed(FixedBuffer& buffer, std::error_code& ec);
+
+        // 分散读取：一次读操作按顺序填充 count 个缓冲区
+        size_t readv(const MutableBuffer* buffers, size_t count, std::error_code& ec);
+
+        // 读取数据到由内核从 ring 中挑选的缓冲区，返回的缓冲区释放时归还
+        // 连接关闭时返回空缓冲区；ring 中没有空闲缓冲区时 ec 为 no_buffer_space
+        ProvidedBuffer read(BufferRing& ring, std::error_code& ec);
+
+        // multishot 读取：首次调用时提交一个持续接收的 recv，之后每次取出所有已到达的数据块
+        // 返回追加到 chunks 的数量，连接关闭时返回 0 且不设置 ec；启用后连接必须在该线程上销毁
+        size_t read_multishot(BufferRing& ring, std::vector<ProvidedBuffer>& chunks, std::error_code& ec);
+
+        // 异步操作的提交原语：在当前线程的 IoContext 上提交请求后立即返回，
+        // 完成时 op->complete 收到传输的字节数或负的错误码；完成前 op 和连接都必须保持有效
+        bool start_read(MutableBuffer buffer, IoOperation* op, std::error_code& ec);
+        bool start_write(ConstBuffer data, IoOperation* op, std::error_code& ec);
+
+        // 在未连接的 TcpStream 上创建套接字并提交连接请求，连接成功时结果为 0
+        bool start_connect(const SocketAddr& address, IoOperation* op, std::error_code& ec);
+
+        // 同上，但只准备请求、不立即提交：地址写入调用者提供的 storage，由调用者决定何时提交
+        // （例如 SubmitBatch::flush），请求完成前 storage 必须保持有效
+        bool start_connect(const SocketAddr& address, sockaddr_storage& storage, IoOperation* op, std::error_code& ec);
+
+        // 回调接口：提交后立即返回，完成时在当前线程的 IoContext 上调用
+        // handler(size_t bytes, std::error_code ec)，提交失败也通过事件循环报告
+        template <typename Handler, enable_if_transfer_handler_t<Handler> = 0>
+        void async_read(MutableBuffer buffer, Handler handler)
+        {
+            HandlerOperation* op = HandlerOperation::create(transfer_handler(std::move(handler)));
+            std::error_code ec;
+            if (!start_read(buffer, op, ec))
+                op->fail(ec);
+        }
+
+        template <typename Handler, enable_if_transfer_handler_t<Handler> = 0>
+        void async_write(ConstBuffer data, Handler handler)
+        {
+            HandlerOperation* op = HandlerOperation::create(transfer_handler(std::move(handler)));
+            std::error_code ec;
+            if (!start_write(data, op, ec))
+                op->fail(ec);
+        }
+
+        // 完成时调用 handler(std::optional<TcpStream> stream, std::error_code ec)
+        template <typename Handler,
+                  std::enable_if_t<std::is_invocable_v<Handler&, std::optional<TcpStream>, std::error_code>, int> = 0>
+        static void async_connect(const SocketAddr& address, Handler handler);
+
+#if defined(__cpp_impl_coroutine)
+        class ReadAwaitable;
+        class WriteAwaitable;
+        class ConnectAwaitable;
+
+        // 协程接口：co_await 的结果与对应的阻塞调用相同，错误写入 ec
+        ReadAwaitable async_read(MutableBuffer buffer, std::error_code& ec);
+        WriteAwaitable async_write(ConstBuffer data, std::error_code& ec);
+        static ConnectAwaitable async_connect(const SocketAddr& address, std::error_code& ec);
+#endif
+
     public:
         class Impl; // 平台特定实现
         Impl* impl_;
     };
 
+    // splice_bidirectional 两个方向各自转发的字节数
+    struct SpliceStats
+    {
+        uint64_t a_to_b = 0;
+        uint64_t b_to_a = 0;
+    };
+
+    // 在两个连接之间双向转发数据，直到两个方向都读到 EOF
+    // 一个方向读到 EOF 时关闭另一端的写方向（半关闭），另一个方向继续转发；任一方向出错时取消另一个方向并设置 ec
+    // Linux 下数据经每个方向的管道用 IORING_OP_SPLICE 在内核中转发，不经过用户空间；其他平台 ec 为 operation_not_supported
+    SpliceStats splice_bidirectional(TcpStream& a, TcpStream& b, std::error_code& ec);
+
+    // 连接中的套接字保存在操作对象里，连接成功后交给回调
+    template <typename Handler,
+              std::enable_if_t<std::is_invocable_v<Handler&, std::optional<TcpStream>, std::error_code>, int>>
+    void TcpStream::async_connect(const SocketAddr& address, Handler handler)
+    {
+        struct ConnectHandler
+        {
+            void operator()(int result)
+            {
+                if (result < 0)
+                    handler(std::nullopt, std::error_code(-result, std::generic_category()));
+                else
+                    handler(std::move(stream), std::error_code());
+            }
+
+            TcpStream stream;
+            Handler handler;
+        };
+
+        HandlerOperation* op = HandlerOperation::create(ConnectHandler{TcpStream(), std::move(handler)});
+        std::error_code ec;
+        if (!op->function<ConnectHandler>().stream.start_connect(address, op, ec))
+            op->fail(ec);
+    }
+
+#if defined(__cpp_impl_coroutine)
+    class TcpStream::ReadAwaitable : public IoAwaitable<TcpStream::ReadAwaitable>
+    {
+    public:
+        ReadAwaitable(TcpStream& stream, MutableBuffer buffer, std::error_code& ec)
+            : IoAwaitable(ec), stream_(stream), buffer_(buffer) {}
+
+        bool start(IoOperation* op, std::error_code& ec) { return stream_.start_read(buffer_, op, ec); }
+        size_t await_resume() { return succeeded() ? static_cast<size_t>(result()) : 0; }
+
+    private:
+        TcpStream& stream_;
+        MutableBuffer buffer_;
+    };
+
+    class TcpStream::WriteAwaitable : public IoAwaitable<TcpStream::WriteAwaitable>
+    {
+    public:
+        WriteAwaitable(TcpStream& stream, ConstBuffer data, std::error_code& ec)
+            : IoAwaitable(ec), stream_(stream), data_(data) {}
+
+        bool start(IoOperation* op, std::error_code& ec) { return stream_.start_write(data_, op, ec); }
+        size_t await_resume() { return succeeded() ? static_cast<size_t>(result()) : 0; }
+
+    private:
+        TcpStream& stream_;
+        ConstBuffer data_;
+    };
+
+    class TcpStream::ConnectAwaitable : public IoAwaitable<TcpStream::ConnectAwaitable>
+    {
+    public:
+        ConnectAwaitable(const SocketAddr& address, std::error_code& ec)
+            : IoAwaitable(ec), address_(address) {}
+
+        bool start(IoOperation* op, std::error_code& ec) { return stream_.start_connect(address_, op, ec); }
+
+        std::optional<TcpStream> await_resume()
+        {
+            if (!succeeded())
+                return std::nullopt;
+            return std::move(stream_);
+        }
+
+    private:
+        SocketAddr address_;
+        TcpStream stream_;
+    };
+
+    inline TcpStream::ReadAwaitable TcpStream::async_read(MutableBuffer buffer, std::error_code& ec)
+    {
+        return ReadAwaitable(*this, buffer, ec);
+    }
+
+    inline TcpStream::WriteAwaitable TcpStream::async_write(ConstBuffer data, std::error_code& ec)
+    {
+        return WriteAwaitable(*this, data, ec);
+    }
+
+    inline TcpStream::ConnectAwaitable TcpStream::async_connect(const SocketAddr& address, std::error_code& ec)
+    {
+        return ConnectAwaitable(address, ec);
+    }
+#endif
+
 } // namespace net
 
 #endif // TCP_STREAM_H
@@ -0,0 +1,89 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace net
+{
+    /// 分层时间轮，用于跟踪大量连接的空闲超时
+    /// 4 层各 256 个槽位，以 resolution 为一个刻度，最长可表示 2^32 - 1 个刻度，更长的超时按最大值处理；
+    /// 登记、刷新和取消都是 O(1)，推进时只处理经过的槽位，到期的条目一次性交给调用者批量关闭
+    /// 不是线程安全的，每个线程（每个 IoContext）使用自己的时间轮
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// 侵入式条目：连接类型继承 Entry，advance 返回后用 static_cast 取回连接
+        /// 条目析构时自动取消登记
+        class Entry
+        {
+        public:
+            Entry() = default;
+            ~Entry();
+
+            /// 登记后时间轮持有条目的地址，不能拷贝或移动
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            bool scheduled() const { return wheel_ != nullptr; }
+
+        private:
+            friend class TimerWheel;
+
+            Entry* prev_ = nullptr;
+            Entry* next_ = nullptr;
+            TimerWheel* wheel_ = nullptr;
+            uint64_t expiry_ = 0;      ///< 到期的刻度
+            uint64_t slot_expiry_ = 0; ///< 所在槽位被处理的刻度，不晚于 expiry_
+        };
+
+        explicit TimerWheel(std::chrono::milliseconds resolution = std::chrono::milliseconds(10),
+                            Clock::time_point now = Clock::now());
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /// 登记 entry，或刷新已登记的 entry：以最近一次 advance 的时间为起点，timeout 后到期
+        /// 刷新只推迟到期时间时不移动链表节点，连接每次收发数据都可以调用
+        void schedule(Entry& entry, std::chrono::milliseconds timeout);
+
+        /// 取消登记，未登记的条目不受影响
+        void cancel(Entry& entry);
+
+        /// 推进到 now，把到期的条目取消登记后追加到 expired，返回追加的数量
+        size_t advance(Clock::time_point now, std::vector<Entry*>& expired);
+
+        /// 下一次需要调用 advance 的时间，没有登记的条目时为 Clock::time_point::max()
+        Clock::time_point next_deadline() const;
+
+        /// 已登记的条目数量
+        size_t size() const { return size_; }
+
+    private:
+        static constexpr unsigned kLevels = 4;
+        static constexpr unsigned kSlotBits = 8;
+        static constexpr unsigned kSlots = 1u << kSlotBits;
+
+        Entry& slot(unsigned level, uint64_t tick) const;
+        void insert(Entry& entry);
+        void process(Entry& head, std::vector<Entry*>& expired);
+
+        static void link(Entry& head, Entry& entry);
+        static void unlink(Entry& entry);
+
+        std::unique_ptr<Entry[]> slots_; ///< 每个槽位是一个带哨兵的双向循环链表
+        Clock::time_point start_;
+        Clock::duration resolution_;
+        uint64_t now_ = 0;
+        size_t size_ = 0;
+    };
+
+} // namespace net
+
+#endif // TIMER_WHEEL_H
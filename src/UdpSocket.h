@@ -5,9 +5,44 @@
 #include <vector>
 #include <optional>
 #include <system_error>
+#include <cstdint>
+#include "Buffer.h"
+#include "BufferPool.h"
+#include "BufferRing.h"
+#include "SocketAddr.h"
+#include "IoContext.h"
+#include "Awaitable.h"
+#include "CompletionHandler.h"
 
 namespace net
 {
+    /// send_batch 中的一条待发送数据报，发送结果写回 bytes_sent 和 error
+    /// 每次调用都会先清除上一次的结果；单条数据报的失败（包括提交队列腾不出位置而未发送）
+    /// 只记录在 error 中，send_batch 的 ec 只在整批无法进行时设置，此时返回 0
+    struct OutgoingDatagram
+    {
+        ConstBuffer data;
+        SocketAddr destination;
+        size_t bytes_sent = 0;
+        std::error_code error;
+    };
+
+    /// recv_batch 收到的一条数据报，payload 指向 buffer 中的数据，
+    /// buffer 释放后 payload 随之失效
+    struct IncomingDatagram
+    {
+        ProvidedBuffer buffer;
+        ConstBuffer payload;
+        SocketAddr source;
+        size_t segment_size = 0; ///< 启用 GRO 时合并前每个分段的大小，未合并时为 0
+    };
+
+    /// UdpSocket::bind 的选项
+    struct UdpBindOptions
+    {
+        /// 设置 SO_REUSEPORT：多个套接字可以绑定同一地址和端口，由内核在它们之间分配数据报
+        bool reuse_port = false;
+    };
 
     class UdpSocket
     {
@@ -21,20 +56,113 @@ namespace net
         UdpSocket(UdpSocket&&) noexcept;
         UdpSocket& operator=(UdpSocket&&) noexcept;
 
-        // 绑定到本地地址和端口
+        // 绑定到本地地址和端口，套接字的地址族跟随 address（IPv4 或 IPv6）
+        // 只能向同一地址族的目标发送；Windows 上只支持 IPv4，IPv6 地址返回 address_family_not_supported
         static std::optional<UdpSocket> bind(const std::string& address, int port, std::error_code& ec);
+        static std::optional<UdpSocket> bind(const std::string& address, int port, const UdpBindOptions& options, std::error_code& ec);
+
+        // 分片绑定：创建 shards 个绑定到同一地址的 SO_REUSEPORT 套接字，并安装按 CPU 选择套接字的 BPF 程序，
+        // 数据报交给与处理其接收的 CPU 对应的套接字，避免跨核访问
+        // 第 i 个套接字对应进程可用的第 i 个 CPU，与 Runtime 固定工作线程的顺序一致，
+        // 应由 Runtime 的第 i 个工作线程使用；shards 为 0 时每个可用 CPU 一个套接字
+        // 任何一个套接字失败时返回空数组，已创建的套接字全部关闭
+        static std::vector<UdpSocket> bind_sharded(const std::string& address, int port, unsigned shards, std::error_code& ec);
+
+        // 把套接字注册到当前线程 io_uring 的固定文件表，该线程上的后续操作不再查找文件表
+        // 注册后套接字必须在该线程上销毁
+        bool register_fixed(std::error_code& ec);
 
         // 发送数据到目标地址
         size_t send_to(const std::vector<uint8_t>& data, const std::string& address, int port, std::error_code& ec);
+        size_t send_to(ConstBuffer data, const std::string& address, int port, std::error_code& ec);
+
+        // 发送数据到预先解析好的目标地址，热路径上不再解析字符串
+        size_t send_to(ConstBuffer data, const SocketAddr& destination, std::error_code& ec);
+
+        // 批量发送 count 条数据报：全部请求准备好后只提交一次，
+        // 每条的结果写回对应的 OutgoingDatagram，返回发送成功的条数
+        size_t send_batch(OutgoingDatagram* datagrams, size_t count, std::error_code& ec);
+
+        // 从缓冲区池中的固定缓冲区发送前 size 个字节到目标地址
+        // Linux 下使用带地址的零拷贝发送；内核拒绝时（EINVAL/EOPNOTSUPP）退回普通 sendto，之后的调用直接普通发送
+        size_t send_to_fixed(const FixedBuffer& buffer, size_t size, const std::string& address, int port, std::error_code& ec);
+        size_t send_to_fixed(const FixedBuffer& buffer, size_t size, const SocketAddr& destination, std::error_code& ec);
 
         // 从远程地址接收数据
         size_t recv_from(std::vector<uint8_t>& buffer, std::string& address, int& port, std::error_code& ec);
+        size_t recv_from(MutableBuffer buffer, std::string& address, int& port, std::error_code& ec);
+
+        // 接收数据报，source 返回二进制形式的发送方地址，不做字符串转换
+        size_t recv_from(MutableBuffer buffer, SocketAddr& source, std::error_code& ec);
+
+        // 接收数据报，启用 GRO 时 segment_size 返回合并前每个分段的大小，未合并时为 0
+        size_t recv_from(MutableBuffer buffer, std::string& address, int& port, size_t& segment_size, std::error_code& ec);
+        size_t recv_from(MutableBuffer buffer, SocketAddr& source, size_t& segment_size, std::error_code& ec);
+
+        // 启用 UDP_GRO，接收时由内核合并同一流的连续数据报
+        bool enable_gro(std::error_code& ec);
+
+        // 使用 UDP_SEGMENT（GSO）发送：data 按 segment_size 切分为多个数据报，只经过一次协议栈
+        size_t send_to_segmented(ConstBuffer data, uint16_t segment_size, const std::string& address, int port, std::error_code& ec);
+        size_t send_to_segmented(ConstBuffer data, uint16_t segment_size, const SocketAddr& destination, std::error_code& ec);
+
+        // 批量接收：首次调用时提交一个 multishot recvmsg，数据报由内核放入 ring 中的缓冲区，
+        // 之后每次取出所有已到达的数据报，返回追加到 datagrams 的数量；启用后套接字必须在该线程上销毁
+        size_t recv_batch(BufferRing& ring, std::vector<IncomingDatagram>& datagrams, std::error_code& ec);
+
+        // 异步接收的提交原语：完成时先填写 source，再由 op->complete 收到字节数或负的错误码
+        // 同一个套接字同一时间只能有一个未完成的异步接收，接收未完成时套接字必须在提交它的线程上销毁
+        bool start_recv_from(MutableBuffer buffer, SocketAddr& source, IoOperation* op, std::error_code& ec);
+
+        // 发送的提交原语：只准备请求、不立即提交，完成时 op->complete 收到发送的字节数或负的错误码
+        // 目标地址写入调用者提供的 storage，请求完成前 data 和 storage 都必须保持有效
+        bool start_send_to(ConstBuffer data, const SocketAddr& destination, sockaddr_storage& storage, IoOperation* op, std::error_code& ec);
+
+        // 回调接口：完成时先填写 source，再在当前线程的 IoContext 上调用
+        // handler(size_t bytes, std::error_code ec)
+        template <typename Handler, enable_if_transfer_handler_t<Handler> = 0>
+        void async_recv_from(MutableBuffer buffer, SocketAddr& source, Handler handler)
+        {
+            HandlerOperation* op = HandlerOperation::create(transfer_handler(std::move(handler)));
+            std::error_code ec;
+            if (!start_recv_from(buffer, source, op, ec))
+                op->fail(ec);
+        }
+
+#if defined(__cpp_impl_coroutine)
+        class RecvFromAwaitable;
+
+        // 协程接口：co_await 得到接收的字节数，错误写入 ec
+        RecvFromAwaitable async_recv_from(MutableBuffer buffer, SocketAddr& source, std::error_code& ec);
+#endif
 
     private:
         class Impl; // 平台特定实现
         Impl* impl_;
     };
 
+#if defined(__cpp_impl_coroutine)
+    class UdpSocket::RecvFromAwaitable : public IoAwaitable<UdpSocket::RecvFromAwaitable>
+    {
+    public:
+        RecvFromAwaitable(UdpSocket& socket, MutableBuffer buffer, SocketAddr& source, std::error_code& ec)
+            : IoAwaitable(ec), socket_(socket), buffer_(buffer), source_(source) {}
+
+        bool start(IoOperation* op, std::error_code& ec) { return socket_.start_recv_from(buffer_, source_, op, ec); }
+        size_t await_resume() { return succeeded() ? static_cast<size_t>(result()) : 0; }
+
+    private:
+        UdpSocket& socket_;
+        MutableBuffer buffer_;
+        SocketAddr& source_;
+    };
+
+    inline UdpSocket::RecvFromAwaitable UdpSocket::async_recv_from(MutableBuffer buffer, SocketAddr& source, std::error_code& ec)
+    {
+        return RecvFromAwaitable(*this, buffer, source, ec);
+    }
+#endif
+
 } // namespace net
 
 #endif // UDP_SOCKET_H
@@ -0,0 +1,158 @@
+#include "SocketAddr.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+namespace net
+{
+    // 解析文本地址
+    std::optional<SocketAddr> SocketAddr::parse(const std::string& address, int port)
+    {
+        if (port < 0 || port > 65535)
+        {
+            return std::nullopt;
+        }
+
+        SocketAddr addr;
+        addr.port_ = static_cast<uint16_t>(port);
+        if (inet_pton(AF_INET, address.c_str(), addr.bytes_) == 1)
+        {
+            addr.family_ = Family::V4;
+            return addr;
+        }
+        if (inet_pton(AF_INET6, address.c_str(), addr.bytes_) == 1)
+        {
+            addr.family_ = Family::V6;
+            return addr;
+        }
+        return std::nullopt;
+    }
+
+    // 从系统地址结构构造
+    SocketAddr SocketAddr::from_sockaddr(const sockaddr* addr, size_t length)
+    {
+        SocketAddr result;
+        if (!addr)
+        {
+            return result;
+        }
+
+        if (addr->sa_family == AF_INET && length >= sizeof(sockaddr_in))
+        {
+            const auto* in = reinterpret_cast<const sockaddr_in*>(addr);
+            std::memcpy(result.bytes_, &in->sin_addr, sizeof(in->sin_addr));
+            result.port_ = ntohs(in->sin_port);
+            result.family_ = Family::V4;
+        }
+        else if (addr->sa_family == AF_INET6 && length >= sizeof(sockaddr_in6))
+        {
+            const auto* in6 = reinterpret_cast<const sockaddr_in6*>(addr);
+            std::memcpy(result.bytes_, &in6->sin6_addr, sizeof(in6->sin6_addr));
+            result.scope_id_ = in6->sin6_scope_id;
+            result.port_ = ntohs(in6->sin6_port);
+            result.family_ = Family::V6;
+        }
+        return result;
+    }
+
+    // 写入系统地址结构
+    size_t SocketAddr::to_sockaddr(sockaddr_storage& storage) const
+    {
+        std::memset(&storage, 0, sizeof(storage));
+        if (family_ == Family::V4)
+        {
+            auto* in = reinterpret_cast<sockaddr_in*>(&storage);
+            in->sin_family = AF_INET;
+            in->sin_port = htons(port_);
+            std::memcpy(&in->sin_addr, bytes_, sizeof(in->sin_addr));
+            return sizeof(sockaddr_in);
+        }
+        if (family_ == Family::V6)
+        {
+            auto* in6 = reinterpret_cast<sockaddr_in6*>(&storage);
+            in6->sin6_family = AF_INET6;
+            in6->sin6_port = htons(port_);
+            in6->sin6_scope_id = scope_id_;
+            std::memcpy(&in6->sin6_addr, bytes_, sizeof(in6->sin6_addr));
+            return sizeof(sockaddr_in6);
+        }
+        return 0;
+    }
+
+    // 地址的文本形式
+    std::string SocketAddr::address() const
+    {
+        char text[INET6_ADDRSTRLEN] = {};
+        if (family_ == Family::V4)
+        {
+            inet_ntop(AF_INET, bytes_, text, sizeof(text));
+        }
+        else if (family_ == Family::V6)
+        {
+            inet_ntop(AF_INET6, bytes_, text, sizeof(text));
+        }
+        return text;
+    }
+
+    std::string SocketAddr::to_string() const
+    {
+        if (family_ == Family::V6)
+        {
+            return "[" + address() + "]:" + std::to_string(port_);
+        }
+        return address() + ":" + std::to_string(port_);
+    }
+
+    // FNV-1a 哈希
+    size_t SocketAddr::hash() const
+    {
+        uint64_t value = 14695981039346656037ull;
+        auto mix = [&value](uint8_t byte)
+        {
+            value ^= byte;
+            value *= 1099511628211ull;
+        };
+
+        size_t length = family_ == Family::V6 ? 16 : 4;
+        for (size_t i = 0; i < length; ++i)
+        {
+            mix(bytes_[i]);
+        }
+        mix(static_cast<uint8_t>(port_ >> 8));
+        mix(static_cast<uint8_t>(port_));
+        mix(static_cast<uint8_t>(family_));
+        return static_cast<size_t>(value);
+    }
+
+    bool SocketAddr::operator==(const SocketAddr& other) const
+    {
+        return family_ == other.family_ && port_ == other.port_ && scope_id_ == other.scope_id_ &&
+               std::memcmp(bytes_, other.bytes_, sizeof(bytes_)) == 0;
+    }
+
+    bool SocketAddr::operator<(const SocketAddr& other) const
+    {
+        if (family_ != other.family_)
+        {
+            return family_ < other.family_;
+        }
+        int order = std::memcmp(bytes_, other.bytes_, sizeof(bytes_));
+        if (order != 0)
+        {
+            return order < 0;
+        }
+        if (port_ != other.port_)
+        {
+            return port_ < other.port_;
+        }
+        return scope_id_ < other.scope_id_;
+    }
+}
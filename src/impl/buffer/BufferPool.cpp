@@ -0,0 +1,114 @@
+#include "BufferPool.h"
+
+#if defined(_WIN32)
+#include "WindowsBufferPool.h"
+#elif defined(__linux__)
+#include "LinuxBufferPool.h"
+#elif defined(__APPLE__)
+#include "MacBufferPool.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // BufferPool 类的构造和析构
+    BufferPool::BufferPool() : impl_(new Impl()) {}
+
+    BufferPool::~BufferPool()
+    {
+        delete impl_;
+    }
+
+    // 移动构造和移动赋值
+    BufferPool::BufferPool(BufferPool&& other) noexcept : impl_(other.impl_)
+    {
+        other.impl_ = nullptr;
+    }
+
+    BufferPool& BufferPool::operator=(BufferPool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            delete impl_;
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    // 创建并注册缓冲区池
+    std::optional<BufferPool> BufferPool::create(size_t slice_size, unsigned slice_count, std::error_code& ec)
+    {
+        BufferPool pool;
+        if (pool.impl_->init(slice_size, slice_count, ec))
+        {
+            return pool;
+        }
+        return std::nullopt;
+    }
+
+    // 借出切片
+    FixedBuffer BufferPool::acquire()
+    {
+        return impl_ ? impl_->acquire() : FixedBuffer();
+    }
+
+    size_t BufferPool::slice_size() const
+    {
+        return impl_ ? impl_->slice_size() : 0;
+    }
+
+    unsigned BufferPool::available() const
+    {
+        return impl_ ? impl_->available() : 0;
+    }
+
+    // FixedBuffer 类的构造和析构
+    FixedBuffer::FixedBuffer() : pool_(nullptr), index_(0), data_(nullptr), capacity_(0) {}
+
+    FixedBuffer::FixedBuffer(BufferPool::Impl* pool, unsigned index, uint8_t* data, size_t capacity)
+        : pool_(pool), index_(index), data_(data), capacity_(capacity) {}
+
+    FixedBuffer::~FixedBuffer()
+    {
+        release();
+    }
+
+    // 移动构造和移动赋值
+    FixedBuffer::FixedBuffer(FixedBuffer&& other) noexcept
+        : pool_(other.pool_), index_(other.index_), data_(other.data_), capacity_(other.capacity_)
+    {
+        other.pool_ = nullptr;
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+    }
+
+    FixedBuffer& FixedBuffer::operator=(FixedBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            pool_ = other.pool_;
+            index_ = other.index_;
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.pool_ = nullptr;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    // 归还切片
+    void FixedBuffer::release()
+    {
+        if (pool_)
+        {
+            pool_->recycle(index_);
+            pool_ = nullptr;
+        }
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+}
@@ -0,0 +1,108 @@
+#include "BufferRing.h"
+
+#if defined(_WIN32)
+#include "WindowsBufferRing.h"
+#elif defined(__linux__)
+#include "LinuxBufferRing.h"
+#elif defined(__APPLE__)
+#include "MacBufferRing.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // BufferRing 类的构造和析构
+    BufferRing::BufferRing() : impl_(new Impl()) {}
+
+    BufferRing::~BufferRing()
+    {
+        delete impl_;
+    }
+
+    // 移动构造和移动赋值
+    BufferRing::BufferRing(BufferRing&& other) noexcept : impl_(other.impl_)
+    {
+        other.impl_ = nullptr;
+    }
+
+    BufferRing& BufferRing::operator=(BufferRing&& other) noexcept
+    {
+        if (this != &other)
+        {
+            delete impl_;
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    // 创建并注册缓冲区池
+    std::optional<BufferRing> BufferRing::create(unsigned count, size_t buffer_size, std::error_code& ec)
+    {
+        BufferRing ring;
+        if (ring.impl_->init(count, buffer_size, ec))
+        {
+            return ring;
+        }
+        return std::nullopt;
+    }
+
+    size_t BufferRing::buffer_size() const
+    {
+        return impl_ ? impl_->buffer_size() : 0;
+    }
+
+    unsigned BufferRing::count() const
+    {
+        return impl_ ? impl_->count() : 0;
+    }
+
+    // ProvidedBuffer 类的构造和析构
+    ProvidedBuffer::ProvidedBuffer() : ring_(nullptr), id_(0), data_(nullptr), size_(0) {}
+
+    ProvidedBuffer::ProvidedBuffer(BufferRing::Impl* ring, uint16_t id, const uint8_t* data, size_t size)
+        : ring_(ring), id_(id), data_(data), size_(size) {}
+
+    ProvidedBuffer::~ProvidedBuffer()
+    {
+        release();
+    }
+
+    // 移动构造和移动赋值
+    ProvidedBuffer::ProvidedBuffer(ProvidedBuffer&& other) noexcept
+        : ring_(other.ring_), id_(other.id_), data_(other.data_), size_(other.size_)
+    {
+        other.ring_ = nullptr;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    ProvidedBuffer& ProvidedBuffer::operator=(ProvidedBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            ring_ = other.ring_;
+            id_ = other.id_;
+            data_ = other.data_;
+            size_ = other.size_;
+            other.ring_ = nullptr;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // 归还缓冲区
+    void ProvidedBuffer::release()
+    {
+        if (ring_)
+        {
+            ring_->recycle(id_);
+            ring_ = nullptr;
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
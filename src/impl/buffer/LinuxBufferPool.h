@@ -0,0 +1,102 @@
+#ifndef LINUX_BUFFER_POOL_H
+#define LINUX_BUFFER_POOL_H
+
+#include <liburing.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <vector>
+#include <cassert>
+#include <system_error>
+#include "BufferPool.h"
+#include "LinuxIoContext.h"
+
+namespace net
+{
+    // BufferPool::Impl for Linux with io_uring registered buffers
+    // 整块内存作为 0 号固定缓冲区注册，切片通过地址偏移引用它
+    class BufferPool::Impl
+    {
+    public:
+        static constexpr int kBufferIndex = 0;
+
+        Impl() = default;
+
+        // 固定缓冲区只能在注册它的线程上注销
+        ~Impl()
+        {
+            assert(!context_ || context_->impl_->is_current());
+            if (context_)
+                io_uring_unregister_buffers(context_->impl_->ring());
+            if (slab_)
+                munmap(slab_, slab_size_);
+        }
+
+        bool init(size_t slice_size, unsigned slice_count, std::error_code &ec)
+        {
+            if (slice_size == 0 || slice_count == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+
+            IoContext &context = IoContext::current();
+            if (!context.impl_->init(ec))
+                return false;
+
+            // 使用匿名映射得到页对齐的内存
+            size_t slab_size = slice_size * slice_count;
+            void *slab = mmap(nullptr, slab_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (slab == MAP_FAILED)
+            {
+                ec = std::make_error_code(std::errc::not_enough_memory);
+                return false;
+            }
+
+            iovec iov = {};
+            iov.iov_base = slab;
+            iov.iov_len = slab_size;
+            int ret = io_uring_register_buffers(context.impl_->ring(), &iov, 1);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                munmap(slab, slab_size);
+                return false;
+            }
+
+            context_ = &context;
+            slab_ = static_cast<uint8_t *>(slab);
+            slab_size_ = slab_size;
+            slice_size_ = slice_size;
+            free_slices_.reserve(slice_count);
+            for (unsigned i = slice_count; i > 0; --i)
+                free_slices_.push_back(i - 1);
+            return true;
+        }
+
+        FixedBuffer acquire()
+        {
+            if (free_slices_.empty())
+                return FixedBuffer();
+
+            unsigned index = free_slices_.back();
+            free_slices_.pop_back();
+            return FixedBuffer(this, index, slab_ + index * slice_size_, slice_size_);
+        }
+
+        void recycle(unsigned index) { free_slices_.push_back(index); }
+
+        IoContext *context() const { return context_; }
+        size_t slice_size() const { return slice_size_; }
+        unsigned available() const { return static_cast<unsigned>(free_slices_.size()); }
+
+    private:
+        IoContext *context_ = nullptr;
+        uint8_t *slab_ = nullptr;
+        size_t slab_size_ = 0;
+        size_t slice_size_ = 0;
+        std::vector<unsigned> free_slices_;
+    };
+
+} // namespace net
+
+#endif // LINUX_BUFFER_POOL_H
@@ -0,0 +1,100 @@
+#ifndef LINUX_BUFFER_RING_H
+#define LINUX_BUFFER_RING_H
+
+#include <liburing.h>
+#include <memory>
+#include <cassert>
+#include <system_error>
+#include "BufferRing.h"
+#include "LinuxIoContext.h"
+
+namespace net
+{
+    // BufferRing::Impl for Linux with io_uring provided buffer ring
+    class BufferRing::Impl
+    {
+    public:
+        Impl() = default;
+
+        // 缓冲区环只能在注册它的线程上注销
+        ~Impl()
+        {
+            assert(!buf_ring_ || context_->impl_->is_current());
+            if (buf_ring_)
+                io_uring_free_buf_ring(context_->impl_->ring(), buf_ring_, count_, group_id_);
+        }
+
+        bool init(unsigned count, size_t buffer_size, std::error_code &ec)
+        {
+            // 缓冲区数量必须是 2 的幂，ID 为 16 位
+            if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || buffer_size == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+
+            IoContext &context = IoContext::current();
+            if (!context.impl_->init(ec))
+                return false;
+
+            // 在当前线程的 io_uring 上注册缓冲区环
+            int group_id = context.impl_->allocate_buffer_group();
+            int ret = 0;
+            io_uring_buf_ring *buf_ring = io_uring_setup_buf_ring(context.impl_->ring(), count, group_id, 0, &ret);
+            if (!buf_ring)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return false;
+            }
+
+            storage_.reset(new uint8_t[count * buffer_size]);
+            context_ = &context;
+            buf_ring_ = buf_ring;
+            group_id_ = static_cast<uint16_t>(group_id);
+            count_ = count;
+            buffer_size_ = buffer_size;
+            mask_ = io_uring_buf_ring_mask(count);
+
+            // 初始时所有缓冲区都交给内核
+            for (unsigned i = 0; i < count; ++i)
+                io_uring_buf_ring_add(buf_ring_, buffer(i), buffer_size_, i, mask_, i);
+            io_uring_buf_ring_advance(buf_ring_, count);
+            return true;
+        }
+
+        // 把借出的缓冲区放回环中
+        void recycle(uint16_t id)
+        {
+            io_uring_buf_ring_add(buf_ring_, buffer(id), buffer_size_, id, mask_, 0);
+            io_uring_buf_ring_advance(buf_ring_, 1);
+        }
+
+        // 根据完成事件的 flags 取出内核选中的缓冲区
+        ProvidedBuffer take(int result, unsigned flags)
+        {
+            if (!(flags & IORING_CQE_F_BUFFER))
+                return ProvidedBuffer();
+
+            auto id = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+            return ProvidedBuffer(this, id, buffer(id), static_cast<size_t>(result));
+        }
+
+        uint8_t *buffer(unsigned id) { return storage_.get() + id * buffer_size_; }
+        IoContext *context() const { return context_; }
+        uint16_t group_id() const { return group_id_; }
+        size_t buffer_size() const { return buffer_size_; }
+        unsigned count() const { return count_; }
+
+    private:
+        IoContext *context_ = nullptr;
+        io_uring_buf_ring *buf_ring_ = nullptr;
+        std::unique_ptr<uint8_t[]> storage_;
+        uint16_t group_id_ = 0;
+        unsigned count_ = 0;
+        size_t buffer_size_ = 0;
+        int mask_ = 0;
+    };
+
+} // namespace net
+
+#endif // LINUX_BUFFER_RING_H
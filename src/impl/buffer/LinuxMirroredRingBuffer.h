@@ -0,0 +1,80 @@
+#ifndef LINUX_MIRRORED_RING_BUFFER_H
+#define LINUX_MIRRORED_RING_BUFFER_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include "MirroredRingBuffer.h"
+
+namespace net
+{
+    // MirroredRingBuffer::Impl for Linux
+    // memfd_create 得到一段匿名共享内存，先保留两倍大小的地址空间，再把它固定映射到前后两半
+    class MirroredRingBuffer::Impl
+    {
+    public:
+        Impl() = default;
+
+        ~Impl()
+        {
+            if (data_)
+                munmap(data_, capacity_ * 2);
+        }
+
+        bool init(size_t capacity, std::error_code &ec)
+        {
+            size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            capacity = (capacity + page_size - 1) / page_size * page_size;
+
+            int fd = memfd_create("net-mirrored-ring", MFD_CLOEXEC);
+            if (fd < 0)
+            {
+                ec.assign(errno, std::system_category());
+                return false;
+            }
+            if (ftruncate(fd, static_cast<off_t>(capacity)) < 0)
+            {
+                ec.assign(errno, std::system_category());
+                close(fd);
+                return false;
+            }
+
+            // 保留连续的地址空间，两次 MAP_FIXED 映射替换其中的前后两半
+            void *base = mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                ec.assign(errno, std::system_category());
+                close(fd);
+                return false;
+            }
+
+            uint8_t *data = static_cast<uint8_t *>(base);
+            if (mmap(data, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+                mmap(data + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                ec.assign(errno, std::system_category());
+                munmap(base, capacity * 2);
+                close(fd);
+                return false;
+            }
+
+            // 映射持有对内存的引用，描述符不再需要
+            close(fd);
+            data_ = data;
+            capacity_ = capacity;
+            return true;
+        }
+
+        uint8_t *data() const { return data_; }
+        size_t capacity() const { return capacity_; }
+
+    private:
+        uint8_t *data_ = nullptr;
+        size_t capacity_ = 0;
+    };
+
+} // namespace net
+
+#endif // LINUX_MIRRORED_RING_BUFFER_H
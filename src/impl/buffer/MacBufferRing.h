@@ -0,0 +1,26 @@
+#ifndef MAC_BUFFER_RING_H
+#define MAC_BUFFER_RING_H
+
+#include <system_error>
+#include "BufferRing.h"
+
+namespace net
+{
+    // 该平台没有内核提供的缓冲区环
+    class BufferRing::Impl
+    {
+    public:
+        bool init(unsigned, size_t, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        void recycle(uint16_t) {}
+        size_t buffer_size() const { return 0; }
+        unsigned count() const { return 0; }
+    };
+
+} // namespace net
+
+#endif // MAC_BUFFER_RING_H
@@ -0,0 +1,99 @@
+#ifndef MAC_MIRRORED_RING_BUFFER_H
+#define MAC_MIRRORED_RING_BUFFER_H
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include "MirroredRingBuffer.h"
+
+namespace net
+{
+    // MirroredRingBuffer::Impl for macOS
+    // 没有 memfd_create，用创建后立即 shm_unlink 的 POSIX 共享内存代替，映射方式与 Linux 相同
+    class MirroredRingBuffer::Impl
+    {
+    public:
+        Impl() = default;
+
+        ~Impl()
+        {
+            if (data_)
+                munmap(data_, capacity_ * 2);
+        }
+
+        bool init(size_t capacity, std::error_code &ec)
+        {
+            size_t page_size = static_cast<size_t>(getpagesize());
+            capacity = (capacity + page_size - 1) / page_size * page_size;
+
+            int fd = open_shared_memory(ec);
+            if (fd < 0)
+                return false;
+            if (ftruncate(fd, static_cast<off_t>(capacity)) < 0)
+            {
+                ec.assign(errno, std::system_category());
+                close(fd);
+                return false;
+            }
+
+            void *base = mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                ec.assign(errno, std::system_category());
+                close(fd);
+                return false;
+            }
+
+            uint8_t *data = static_cast<uint8_t *>(base);
+            if (mmap(data, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+                mmap(data + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                ec.assign(errno, std::system_category());
+                munmap(base, capacity * 2);
+                close(fd);
+                return false;
+            }
+
+            close(fd);
+            data_ = data;
+            capacity_ = capacity;
+            return true;
+        }
+
+        uint8_t *data() const { return data_; }
+        size_t capacity() const { return capacity_; }
+
+    private:
+        // 用进程号和序号生成不冲突的名字，打开后立即删除名字，只留下描述符
+        static int open_shared_memory(std::error_code &ec)
+        {
+            static std::atomic<unsigned> sequence{0};
+            for (;;)
+            {
+                std::string name = "/net-ring-" + std::to_string(getpid()) + "-" + std::to_string(sequence++);
+                int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd >= 0)
+                {
+                    shm_unlink(name.c_str());
+                    return fd;
+                }
+                if (errno != EEXIST)
+                {
+                    ec.assign(errno, std::system_category());
+                    return -1;
+                }
+            }
+        }
+
+        uint8_t *data_ = nullptr;
+        size_t capacity_ = 0;
+    };
+
+} // namespace net
+
+#endif // MAC_MIRRORED_RING_BUFFER_H
@@ -0,0 +1,108 @@
+#include "MirroredRingBuffer.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include "WindowsMirroredRingBuffer.h"
+#elif defined(__linux__)
+#include "LinuxMirroredRingBuffer.h"
+#elif defined(__APPLE__)
+#include "MacMirroredRingBuffer.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // MirroredRingBuffer 类的构造和析构
+    MirroredRingBuffer::MirroredRingBuffer() : impl_(new Impl()) {}
+
+    MirroredRingBuffer::~MirroredRingBuffer()
+    {
+        delete impl_;
+    }
+
+    // 移动构造和移动赋值
+    MirroredRingBuffer::MirroredRingBuffer(MirroredRingBuffer&& other) noexcept
+        : impl_(other.impl_), data_(other.data_), capacity_(other.capacity_), head_(other.head_), size_(other.size_)
+    {
+        other.impl_ = nullptr;
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+        other.head_ = 0;
+        other.size_ = 0;
+    }
+
+    MirroredRingBuffer& MirroredRingBuffer::operator=(MirroredRingBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            delete impl_;
+            impl_ = other.impl_;
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            head_ = other.head_;
+            size_ = other.size_;
+            other.impl_ = nullptr;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+            other.head_ = 0;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // 创建并映射缓冲区
+    std::optional<MirroredRingBuffer> MirroredRingBuffer::create(size_t capacity, std::error_code& ec)
+    {
+        if (capacity == 0)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return std::nullopt;
+        }
+
+        MirroredRingBuffer buffer;
+        if (!buffer.impl_->init(capacity, ec))
+            return std::nullopt;
+        buffer.data_ = buffer.impl_->data();
+        buffer.capacity_ = buffer.impl_->capacity();
+        return buffer;
+    }
+
+    void MirroredRingBuffer::commit(size_t size)
+    {
+        size_ += std::min(size, capacity_ - size_);
+    }
+
+    // 起点越过第一份映射时回到开头，两份映射中的数据相同
+    void MirroredRingBuffer::consume(size_t size)
+    {
+        size = std::min(size, size_);
+        size_ -= size;
+        head_ += size;
+        if (head_ >= capacity_)
+            head_ -= capacity_;
+    }
+
+    void MirroredRingBuffer::clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // 从连接读取一次
+    size_t MirroredRingBuffer::fill(TcpStream& stream, std::error_code& ec)
+    {
+        if (full())
+        {
+            ec = std::make_error_code(std::errc::value_too_large);
+            return 0;
+        }
+
+        size_t bytes_read = stream.read(writable(), ec);
+        if (ec)
+            return 0;
+        commit(bytes_read);
+        return bytes_read;
+    }
+}
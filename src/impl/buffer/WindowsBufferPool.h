@@ -0,0 +1,27 @@
+#ifndef WINDOWS_BUFFER_POOL_H
+#define WINDOWS_BUFFER_POOL_H
+
+#include <system_error>
+#include "BufferPool.h"
+
+namespace net
+{
+    // 该平台没有可注册给内核的固定缓冲区
+    class BufferPool::Impl
+    {
+    public:
+        bool init(size_t, unsigned, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        FixedBuffer acquire() { return FixedBuffer(); }
+        void recycle(unsigned) {}
+        size_t slice_size() const { return 0; }
+        unsigned available() const { return 0; }
+    };
+
+} // namespace net
+
+#endif // WINDOWS_BUFFER_POOL_H
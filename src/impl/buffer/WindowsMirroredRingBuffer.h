@@ -0,0 +1,89 @@
+#ifndef WINDOWS_MIRRORED_RING_BUFFER_H
+#define WINDOWS_MIRRORED_RING_BUFFER_H
+
+#include <windows.h>
+#include <cstdint>
+#include <system_error>
+#include "MirroredRingBuffer.h"
+
+namespace net
+{
+    // MirroredRingBuffer::Impl for Windows
+    // 页面文件支持的文件映射，在探测到的空闲地址上前后映射两个视图
+    // 释放保留的地址到映射视图之间可能被其他线程占用，失败时重试
+    class MirroredRingBuffer::Impl
+    {
+    public:
+        static constexpr int kMapAttempts = 16;
+
+        Impl() = default;
+
+        ~Impl()
+        {
+            if (data_)
+            {
+                UnmapViewOfFile(data_ + capacity_);
+                UnmapViewOfFile(data_);
+            }
+        }
+
+        bool init(size_t capacity, std::error_code& ec)
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            size_t granularity = info.dwAllocationGranularity;
+            capacity = (capacity + granularity - 1) / granularity * granularity;
+
+            ULONGLONG size = capacity;
+            HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                                static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+            if (!mapping)
+            {
+                ec.assign(static_cast<int>(GetLastError()), std::system_category());
+                return false;
+            }
+
+            uint8_t* data = nullptr;
+            for (int attempt = 0; attempt < kMapAttempts && !data; ++attempt)
+            {
+                // 找到一段足够大的空闲地址后释放，再在上面映射两个视图
+                void* base = VirtualAlloc(nullptr, capacity * 2, MEM_RESERVE, PAGE_NOACCESS);
+                if (!base)
+                    break;
+                VirtualFree(base, 0, MEM_RELEASE);
+
+                uint8_t* first = static_cast<uint8_t*>(MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, base));
+                if (!first)
+                    continue;
+                if (!MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, first + capacity))
+                {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+                data = first;
+            }
+
+            // 视图持有对映射的引用，句柄不再需要
+            CloseHandle(mapping);
+            if (!data)
+            {
+                ec = std::make_error_code(std::errc::not_enough_memory);
+                return false;
+            }
+
+            data_ = data;
+            capacity_ = capacity;
+            return true;
+        }
+
+        uint8_t* data() const { return data_; }
+        size_t capacity() const { return capacity_; }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t capacity_ = 0;
+    };
+
+} // namespace net
+
+#endif // WINDOWS_MIRRORED_RING_BUFFER_H
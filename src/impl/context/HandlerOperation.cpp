@@ -0,0 +1,81 @@
+#include "CompletionHandler.h"
+
+#include <vector>
+
+namespace net
+{
+    namespace
+    {
+        // 每个线程缓存的空闲操作对象数量上限
+        constexpr size_t kMaxPooledOperations = 1024;
+
+        // 操作对象总是在发起它的线程上完成，池按线程划分，不需要加锁
+        struct OperationPool
+        {
+            ~OperationPool()
+            {
+                for (HandlerOperation* op : free_list)
+                {
+                    delete op;
+                }
+            }
+
+            std::vector<HandlerOperation*> free_list;
+        };
+
+        OperationPool& pool()
+        {
+            thread_local OperationPool instance;
+            return instance;
+        }
+    }
+
+    // 从当前线程的池中取出操作对象，池为空时新建
+    HandlerOperation* HandlerOperation::allocate()
+    {
+        OperationPool& operations = pool();
+        HandlerOperation* op = nullptr;
+        if (operations.free_list.empty())
+        {
+            op = new HandlerOperation();
+        }
+        else
+        {
+            op = operations.free_list.back();
+            operations.free_list.pop_back();
+        }
+        op->complete = &HandlerOperation::on_complete;
+        return op;
+    }
+
+    // 归还操作对象，超过缓存上限时直接释放
+    void HandlerOperation::deallocate(HandlerOperation* op)
+    {
+        OperationPool& operations = pool();
+        if (operations.free_list.size() < kMaxPooledOperations)
+        {
+            operations.free_list.push_back(op);
+        }
+        else
+        {
+            delete op;
+        }
+    }
+
+    void HandlerOperation::on_complete(IoOperation* op, int result, unsigned)
+    {
+        auto* self = static_cast<HandlerOperation*>(op);
+        self->invoke_(self, self->error_ != 0 ? self->error_ : result);
+    }
+
+    // 通过事件循环报告提交失败，事件循环不可用时只能直接调用
+    void HandlerOperation::fail(const std::error_code& error)
+    {
+        error_ = error.value() != 0 ? -error.value() : -static_cast<int>(std::errc::io_error);
+        std::error_code ec;
+        if (!IoContext::current().post(this, ec))
+        {
+            invoke_(this, error_);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "IoContext.h"
+
+#if defined(_WIN32)
+#include "WindowsIoContext.h"
+#elif defined(__linux__)
+#include "LinuxIoContext.h"
+#elif defined(__APPLE__)
+#include "MacIoContext.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // IoContext 类的构造和析构
+    IoContext::IoContext() : impl_(new Impl()) {}
+
+    IoContext::~IoContext()
+    {
+        delete impl_;
+    }
+
+    // 每个线程一个实例
+    IoContext& IoContext::current()
+    {
+        thread_local IoContext context;
+        return context;
+    }
+
+    // 设置 io_uring 的创建参数
+    bool IoContext::configure(const RingConfig& config, std::error_code& ec)
+    {
+        return impl_->configure(config, ec);
+    }
+
+    // 处理一轮完成事件
+    size_t IoContext::run_once(std::error_code& ec)
+    {
+        return impl_->run_once(ec);
+    }
+
+    // 非阻塞地处理完成事件
+    size_t IoContext::poll(std::error_code& ec)
+    {
+        return impl_->poll(ec);
+    }
+
+    // 运行事件循环
+    size_t IoContext::run(std::error_code& ec)
+    {
+        return impl_->run(ec);
+    }
+
+    // 停止事件循环
+    void IoContext::stop()
+    {
+        impl_->stop();
+    }
+
+    // 投递一个操作到事件循环
+    bool IoContext::post(IoOperation* op, std::error_code& ec)
+    {
+        return impl_->post(op, ec);
+    }
+
+    // 提交一个定时器
+    bool IoContext::start_timer(std::chrono::nanoseconds timeout, IoOperation* op, std::error_code& ec)
+    {
+        return impl_->start_timer(timeout, op, ec);
+    }
+
+    // 注册固定文件表
+    bool IoContext::enable_fixed_files(unsigned count, std::error_code& ec)
+    {
+        return impl_->enable_fixed_files(count, ec);
+    }
+}
\ No newline at end of file
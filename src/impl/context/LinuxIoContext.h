@@ -0,0 +1,576 @@
+#ifndef LINUX_IO_CONTEXT_H
+#define LINUX_IO_CONTEXT_H
+
+#include <liburing.h>
+#include <cerrno>
+#include <chrono>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "IoContext.h"
+
+namespace net
+{
+    // 阻塞调用使用的操作对象，记录完成事件的结果
+    // 零拷贝发送等请求会先后产生结果和通知两个事件，收到最后一个事件才算完成
+    struct SyncOperation : IoOperation
+    {
+        SyncOperation() { complete = &SyncOperation::on_complete; }
+
+        static void on_complete(IoOperation *op, int result, unsigned flags)
+        {
+            auto *self = static_cast<SyncOperation *>(op);
+            if (!(flags & IORING_CQE_F_NOTIF))
+            {
+                self->result = result;
+                self->flags = flags;
+            }
+            if (!(flags & IORING_CQE_F_MORE))
+                self->done = true;
+        }
+
+        int result = 0;
+        unsigned flags = 0;
+        bool done = false;
+    };
+
+    // IoContext::Impl for Linux with io_uring
+    class IoContext::Impl
+    {
+    public:
+        static constexpr unsigned kDefaultFixedFiles = 1024;
+
+        Impl() = default;
+
+        ~Impl()
+        {
+            if (initialized_)
+                io_uring_queue_exit(&ring_);
+        }
+
+        // 本实例是否属于调用线程；挂在 io_uring 上的请求、固定文件和注册的缓冲区只能在所属线程上清理
+        bool is_current() const { return IoContext::current().impl_ == this; }
+
+        // 保存创建参数，io_uring 实例已创建时不能再修改
+        bool configure(const RingConfig &config, std::error_code &ec)
+        {
+            if (initialized_)
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+            config_ = config;
+            return true;
+        }
+
+        // 首次使用时按创建参数创建 io_uring 实例
+        bool init(std::error_code &ec)
+        {
+            if (initialized_)
+                return true;
+
+            int ret = setup(config_, ring_);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return false;
+            }
+            initialized_ = true;
+            return true;
+        }
+
+        // 按 config 创建一个 io_uring 实例，失败时返回负的错误码
+        static int setup(const RingConfig &config, io_uring &ring)
+        {
+            io_uring_params params = {};
+            if (config.cq_entries > 0)
+            {
+                params.flags |= IORING_SETUP_CQSIZE;
+                params.cq_entries = config.cq_entries;
+            }
+            if (config.sqpoll)
+            {
+                params.flags |= IORING_SETUP_SQPOLL;
+                params.sq_thread_idle = config.sq_thread_idle;
+                if (config.sq_thread_cpu >= 0)
+                {
+                    params.flags |= IORING_SETUP_SQ_AFF;
+                    params.sq_thread_cpu = static_cast<unsigned>(config.sq_thread_cpu);
+                }
+            }
+            if (config.single_issuer || config.defer_taskrun)
+                params.flags |= IORING_SETUP_SINGLE_ISSUER;
+            if (config.defer_taskrun)
+                params.flags |= IORING_SETUP_DEFER_TASKRUN;
+            if (config.coop_taskrun)
+                params.flags |= IORING_SETUP_COOP_TASKRUN;
+            return io_uring_queue_init_params(config.queue_depth, &ring, &params);
+        }
+
+        // 用 config 试建并立即销毁一个实例，在启动工作线程前检查内核是否支持这些参数
+        static bool probe(const RingConfig &config, std::error_code &ec)
+        {
+            io_uring ring = {};
+            int ret = setup(config, ring);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return false;
+            }
+            io_uring_queue_exit(&ring);
+            return true;
+        }
+
+        io_uring *ring() { return &ring_; }
+
+        // 注册一张稀疏的固定文件表，套接字之后可以注册到其中的槽位
+        bool enable_fixed_files(unsigned count, std::error_code &ec)
+        {
+            if (!init(ec))
+                return false;
+            if (file_slots_ > 0)
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+
+            int ret = io_uring_register_files_sparse(&ring_, count);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return false;
+            }
+
+            // 倒序放入空闲列表，优先分配小的槽位
+            file_slots_ = count;
+            free_file_slots_.reserve(count);
+            for (unsigned i = count; i > 0; --i)
+                free_file_slots_.push_back(static_cast<int>(i - 1));
+            return true;
+        }
+
+        // 分配一个空闲槽位，尚未注册固定文件表时按默认大小注册
+        int allocate_file_slot(std::error_code &ec)
+        {
+            if (file_slots_ == 0 && !enable_fixed_files(kDefaultFixedFiles, ec))
+                return -1;
+            if (free_file_slots_.empty())
+            {
+                ec = std::make_error_code(std::errc::too_many_files_open);
+                return -1;
+            }
+            int slot = free_file_slots_.back();
+            free_file_slots_.pop_back();
+            return slot;
+        }
+
+        // 把已有的描述符放入固定文件表，返回槽位
+        int register_file(int fd, std::error_code &ec)
+        {
+            int slot = allocate_file_slot(ec);
+            if (slot < 0)
+                return -1;
+
+            int ret = io_uring_register_files_update(&ring_, slot, &fd, 1);
+            if (ret < 0)
+            {
+                free_file_slots_.push_back(slot);
+                ec = std::error_code(-ret, std::generic_category());
+                return -1;
+            }
+            return slot;
+        }
+
+        // 清空槽位并放回空闲列表；槽位是连接的唯一引用时，连接随之关闭
+        void release_file_slot(int slot)
+        {
+            int fd = -1;
+            io_uring_register_files_update(&ring_, slot, &fd, 1);
+            free_file_slots_.push_back(slot);
+        }
+
+        // 为 provided buffer ring 分配一个在本 io_uring 内唯一的缓冲区组 ID
+        int allocate_buffer_group() { return next_buffer_group_++; }
+
+        // 获取一个 SQE，提交队列已满时先把已有的条目提交给内核
+        io_uring_sqe *get_sqe(std::error_code &ec)
+        {
+            if (!init(ec))
+                return nullptr;
+
+            io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+            if (!sqe)
+            {
+                make_room(1);
+                sqe = io_uring_get_sqe(&ring_);
+            }
+            if (!sqe)
+                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+            return sqe;
+        }
+
+        // 获取一个 SQE；timeout 大于 0 时同时为随后链接的超时请求预留位置，保证两者在同一批中提交
+        io_uring_sqe *get_sqe(std::chrono::nanoseconds timeout, std::error_code &ec)
+        {
+            if (timeout.count() > 0 && !reserve(2, ec))
+                return nullptr;
+            return get_sqe(ec);
+        }
+
+        // 为随后链接在一起的 count 个请求预留位置，之后的 get_sqe 不会在链中途提交
+        // 腾不出位置（提交失败）时 ec 为 resource_unavailable_try_again
+        bool reserve(unsigned count, std::error_code &ec)
+        {
+            if (!init(ec))
+                return false;
+            if (io_uring_sq_space_left(&ring_) < count)
+                make_room(count);
+            if (io_uring_sq_space_left(&ring_) < count)
+            {
+                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+                return false;
+            }
+            return true;
+        }
+
+        // 把 SQE 与操作对象关联，完成事件将分发给该对象
+        void prepare(io_uring_sqe *sqe, IoOperation *op)
+        {
+            io_uring_sqe_set_data(sqe, op);
+            ++pending_;
+        }
+
+        // 提交一个空操作，下一次分发完成事件时以结果 0 调用 op
+        bool post(IoOperation *op, std::error_code &ec)
+        {
+            io_uring_sqe *sqe = get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_nop(sqe);
+            prepare(sqe, op);
+            return true;
+        }
+
+        // 立即把已准备的请求提交给内核，不等待完成；返回时内核已读取全部 SQE，
+        // 请求引用的栈上参数（地址、超时时间等）随后即可释放
+        bool submit(std::error_code &ec)
+        {
+            int ret = io_uring_submit(&ring_);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return false;
+            }
+
+            // SQPOLL 下 io_uring_submit 只更新队尾，需要等轮询线程取走这些条目
+            if (config_.sqpoll)
+            {
+                while (io_uring_sq_ready(&ring_) > 0)
+                    std::this_thread::yield();
+            }
+            return true;
+        }
+
+        // 驱动事件循环直到指定的阻塞操作完成，期间其他操作的完成事件照常分发
+        // 事件循环出错时请求仍在内核中，之后的完成事件会写入 op 所在的栈帧：
+        // 这时取消请求并等到它的最后一个完成事件才返回 false，返回后 op 和请求引用的缓冲区都可以释放
+        bool wait(SyncOperation &op, std::error_code &ec)
+        {
+            auto done = [&op] { return op.done; };
+            if (wait_until(done, ec))
+                return true;
+            cancel(&op, done);
+            return false;
+        }
+
+        // 取消 op 并驱动事件循环直到 done() 返回 true，用于撤销不会自行结束的请求（multishot 等）
+        // 不因错误提前返回，没有空闲 SQE 时在下一轮重试取消
+        template <typename Predicate>
+        void cancel(IoOperation *op, Predicate done)
+        {
+            bool canceled = false;
+            while (!done())
+            {
+                if (!canceled)
+                    canceled = cancel(op);
+                settle_once();
+            }
+        }
+
+        // 提交一个取消 op 的请求，取消请求本身的完成事件被忽略；没有空闲 SQE 时返回 false
+        bool cancel(IoOperation *op)
+        {
+            std::error_code ec;
+            io_uring_sqe *sqe = get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_cancel(sqe, op, 0);
+            prepare(sqe, nullptr);
+            return true;
+        }
+
+        // 出错或析构时的收尾：驱动事件循环直到 done() 返回 true，不因错误提前返回
+        // 用于等待引用了栈上或即将释放的对象的请求全部完成，调用者负责先取消不会自行结束的请求
+        template <typename Predicate>
+        void settle(Predicate done)
+        {
+            while (!done())
+                settle_once();
+        }
+
+        // 提交 sqe 并等待其完成；timeout 大于 0 时在其后链接一个 IORING_OP_LINK_TIMEOUT，
+        // 与请求在同一次系统调用中提交。到期时内核取消请求，op.result 为 -ETIMEDOUT
+        // sqe 必须由 get_sqe(timeout, ec) 取得
+        bool wait(io_uring_sqe *sqe, SyncOperation &op, std::chrono::nanoseconds timeout, std::error_code &ec)
+        {
+            // 超时时间在提交时由内核复制，提交发生在下面的等待中
+            __kernel_timespec ts = to_timespec(timeout);
+            prepare(sqe, &op);
+            if (timeout.count() > 0)
+            {
+                sqe->flags |= IOSQE_IO_LINK;
+                io_uring_sqe *timer = io_uring_get_sqe(&ring_);
+                io_uring_prep_link_timeout(timer, &ts, 0);
+                prepare(timer, nullptr);
+            }
+
+            if (!wait(op, ec))
+                return false;
+            if (timeout.count() > 0 && op.result == -ECANCELED)
+                op.result = -ETIMEDOUT;
+            return true;
+        }
+
+        // 驱动事件循环直到 done() 返回 true
+        template <typename Predicate>
+        bool wait_until(Predicate done, std::error_code &ec)
+        {
+            while (!done())
+            {
+                run_once(ec);
+                if (ec)
+                    return false;
+            }
+            return true;
+        }
+
+        size_t run_once(std::error_code &ec)
+        {
+            return submit_and_wait(1, ec);
+        }
+
+        // 一次系统调用提交所有已准备的请求，并等待至少 wait_nr 个完成事件后分发全部已就绪的事件
+        size_t submit_and_wait(unsigned wait_nr, std::error_code &ec)
+        {
+            if (!init(ec))
+                return 0;
+
+            int ret;
+            do
+            {
+                ret = io_uring_submit_and_wait(&ring_, has_reaped() ? 0 : wait_nr);
+            } while (ret == -EINTR);
+
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return 0;
+            }
+            return dispatch_ready();
+        }
+
+        // 与 run_once 相同，但最多等待 timeout，期间没有完成事件时返回 0 且不设置 ec
+        // 等待时间由 io_uring_enter 的参数传给内核，不占用提交队列
+        size_t run_once(std::chrono::nanoseconds timeout, std::error_code &ec)
+        {
+            if (!init(ec))
+                return 0;
+
+            __kernel_timespec ts = to_timespec(timeout);
+
+            io_uring_cqe *cqe = nullptr;
+            int ret;
+            do
+            {
+                if (has_reaped())
+                    ret = io_uring_submit(&ring_);
+                else
+                    ret = io_uring_submit_and_wait_timeout(&ring_, &cqe, 1, &ts, nullptr);
+            } while (ret == -EINTR);
+
+            if (ret < 0 && ret != -ETIME)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return 0;
+            }
+            return dispatch_ready();
+        }
+
+        // 驱动事件循环直到 done() 返回 true 或超过 timeout，超时时 ec 为 timed_out
+        // timeout 为 0 时与 wait_until(done, ec) 相同
+        template <typename Predicate>
+        bool wait_until(Predicate done, std::chrono::nanoseconds timeout, std::error_code &ec)
+        {
+            if (timeout.count() <= 0)
+                return wait_until(done, ec);
+
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (!done())
+            {
+                auto remaining = deadline - std::chrono::steady_clock::now();
+                if (remaining.count() <= 0)
+                {
+                    ec = std::make_error_code(std::errc::timed_out);
+                    return false;
+                }
+                run_once(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining), ec);
+                if (ec)
+                    return false;
+            }
+            return true;
+        }
+
+        // 提交一个 IORING_OP_TIMEOUT，timeout 后以 -ETIME 调用 op；立即提交，不要求调用者保留时间参数
+        bool start_timer(std::chrono::nanoseconds timeout, IoOperation *op, std::error_code &ec)
+        {
+            io_uring_sqe *sqe = get_sqe(ec);
+            if (!sqe)
+                return false;
+
+            __kernel_timespec ts = to_timespec(timeout);
+            io_uring_prep_timeout(sqe, &ts, 0, 0);
+            prepare(sqe, op);
+            return submit(ec);
+        }
+
+        size_t poll(std::error_code &ec)
+        {
+            if (!init(ec))
+                return 0;
+
+            // DEFER_TASKRUN 下完成事件只在进入内核收取事件时产生
+            int ret = config_.defer_taskrun ? io_uring_submit_and_get_events(&ring_) : io_uring_submit(&ring_);
+            if (ret < 0)
+            {
+                ec = std::error_code(-ret, std::generic_category());
+                return 0;
+            }
+            return dispatch_ready();
+        }
+
+        size_t run(std::error_code &ec)
+        {
+            size_t count = 0;
+            stopped_ = false;
+            while (!stopped_ && pending_ > 0)
+            {
+                count += run_once(ec);
+                if (ec)
+                    break;
+            }
+            return count;
+        }
+
+        void stop() { stopped_ = true; }
+
+    private:
+        // 推进一次事件循环；出错时分发已经到达的完成事件，让出 CPU 后由调用者重试
+        void settle_once()
+        {
+            std::error_code ec;
+            run_once(ec);
+            if (ec)
+            {
+                dispatch_ready();
+                std::this_thread::yield();
+            }
+        }
+
+        // 提交已有的条目腾出位置；SQPOLL 下要等轮询线程取走条目后才有空位
+        void make_room(unsigned count)
+        {
+            io_uring_submit(&ring_);
+            if (config_.sqpoll)
+            {
+                while (io_uring_sq_space_left(&ring_) < count)
+                    std::this_thread::yield();
+            }
+        }
+
+        static __kernel_timespec to_timespec(std::chrono::nanoseconds timeout)
+        {
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            __kernel_timespec ts = {};
+            ts.tv_sec = seconds.count();
+            ts.tv_nsec = (timeout - seconds).count();
+            return ts;
+        }
+
+        // 分发所有已就绪的事件：用 io_uring_peek_batch_cqe 一次取出一批，复制后一次推进完成队列
+        // 回调里的阻塞调用重入事件循环时，先分发本批中尚未分发的事件，再收取新的一批
+        size_t dispatch_ready()
+        {
+            size_t count = 0;
+            while (reaped_next_ < reaped_count_ || reap())
+            {
+                Completion completion = reaped_[reaped_next_++];
+
+                // 多次完成的请求（multishot 等）在最后一个事件到达前仍然挂起
+                if (!(completion.flags & IORING_CQE_F_MORE) && pending_ > 0)
+                    --pending_;
+                if (completion.op && completion.op->complete)
+                    completion.op->complete(completion.op, completion.result, completion.flags);
+                ++count;
+            }
+            return count;
+        }
+
+        // 从完成队列收取一批事件，没有事件时返回 false
+        bool reap()
+        {
+            io_uring_cqe *cqes[kReapBatch];
+            unsigned ready;
+            reaped_next_ = 0;
+            reaped_count_ = 0;
+            while (reaped_count_ == 0 && (ready = io_uring_peek_batch_cqe(&ring_, cqes, kReapBatch)) > 0)
+            {
+                for (unsigned i = 0; i < ready; ++i)
+                {
+                    // 不支持等待参数的旧内核上，liburing 用内部的超时请求实现带超时的等待
+                    if (cqes[i]->user_data == LIBURING_UDATA_TIMEOUT)
+                        continue;
+                    reaped_[reaped_count_++] = {static_cast<IoOperation *>(io_uring_cqe_get_data(cqes[i])), cqes[i]->res, cqes[i]->flags};
+                }
+                io_uring_cq_advance(&ring_, ready);
+            }
+            return reaped_count_ > 0;
+        }
+
+        // 已收取但尚未分发的事件不在完成队列里，有这样的事件时不能阻塞等待
+        bool has_reaped() const { return reaped_next_ < reaped_count_; }
+
+        static constexpr unsigned kReapBatch = 64;
+
+        struct Completion
+        {
+            IoOperation *op;
+            int result;
+            unsigned flags;
+        };
+
+        io_uring ring_ = {};
+        RingConfig config_;
+        bool initialized_ = false;
+        bool stopped_ = false;
+        size_t pending_ = 0;
+        Completion reaped_[kReapBatch];
+        unsigned reaped_next_ = 0;
+        unsigned reaped_count_ = 0;
+        int next_buffer_group_ = 0;
+        unsigned file_slots_ = 0;
+        std::vector<int> free_file_slots_;
+    };
+
+} // namespace net
+
+#endif // LINUX_IO_CONTEXT_H
@@ -0,0 +1,50 @@
+#ifndef MAC_IO_CONTEXT_H
+#define MAC_IO_CONTEXT_H
+
+#include <system_error>
+#include "IoContext.h"
+
+namespace net
+{
+    // 该平台的套接字使用阻塞调用，没有需要分发的完成事件
+    class IoContext::Impl
+    {
+    public:
+        size_t run_once(std::error_code &) { return 0; }
+        size_t submit_and_wait(unsigned, std::error_code &) { return 0; }
+        size_t poll(std::error_code &) { return 0; }
+        size_t run(std::error_code &) { return 0; }
+        void stop() {}
+
+        // 该平台没有进行中的请求，取消和收尾都不需要等待
+        template <typename Predicate>
+        void cancel(IoOperation *, Predicate) {}
+
+        template <typename Predicate>
+        void settle(Predicate) {}
+
+        // 该平台没有 io_uring，创建参数不起作用
+        bool configure(const RingConfig &, std::error_code &) { return true; }
+
+        bool post(IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_timer(std::chrono::nanoseconds, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool enable_fixed_files(unsigned, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+    };
+
+} // namespace net
+
+#endif // MAC_IO_CONTEXT_H
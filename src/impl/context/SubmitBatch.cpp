@@ -0,0 +1,113 @@
+#include "SubmitBatch.h"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include "WindowsIoContext.h"
+#elif defined(__linux__)
+#include <sys/socket.h>
+#include "LinuxIoContext.h"
+#elif defined(__APPLE__)
+#include <sys/socket.h>
+#include "MacIoContext.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // 批绑定到创建它的线程的事件循环
+    SubmitBatch::SubmitBatch() : context_(IoContext::current()) {}
+
+    // 已进入提交队列的请求不能撤回，析构前等待它们完成
+    // 事件循环出错时逐个取消仍在进行的请求，内核不再引用操作对象后才释放
+    SubmitBatch::~SubmitBatch()
+    {
+        std::error_code ec;
+        if (flush(ec))
+            return;
+        for (Entry& entry : entries_)
+        {
+            if (entry.in_flight)
+                context_.impl_->cancel(&entry, [&entry] { return !entry.in_flight; });
+        }
+    }
+
+    // 准备读取请求
+    size_t SubmitBatch::read(TcpStream& stream, MutableBuffer buffer)
+    {
+        return add([&](IoOperation* op, std::error_code& ec) { return stream.start_read(buffer, op, ec); });
+    }
+
+    // 准备写入请求
+    size_t SubmitBatch::write(TcpStream& stream, ConstBuffer data)
+    {
+        return add([&](IoOperation* op, std::error_code& ec) { return stream.start_write(data, op, ec); });
+    }
+
+    // 准备连接请求，地址保存在批中，随其他请求一起提交
+    size_t SubmitBatch::connect(TcpStream& stream, const SocketAddr& address)
+    {
+        Entry& entry = next_entry();
+        sockaddr_storage& storage = address_of(entry);
+        auto start = [&](IoOperation* op, std::error_code& ec) { return stream.start_connect(address, storage, op, ec); };
+        return prepare(entry, start);
+    }
+
+    // 准备发送数据报的请求
+    size_t SubmitBatch::send_to(UdpSocket& socket, ConstBuffer data, const SocketAddr& destination)
+    {
+        Entry& entry = next_entry();
+        sockaddr_storage& storage = address_of(entry);
+        auto start = [&](IoOperation* op, std::error_code& ec) { return socket.start_send_to(data, destination, storage, op, ec); };
+        return prepare(entry, start);
+    }
+
+    // 一次系统调用提交全部请求，并等待与未完成请求数量相同的完成事件
+    // 其他操作的完成事件也计入等待数量，因此可能需要再等一轮
+    bool SubmitBatch::flush(std::error_code& ec)
+    {
+        while (pending_ > 0)
+        {
+            context_.impl_->submit_and_wait(static_cast<unsigned>(pending_), ec);
+            if (ec)
+                return false;
+        }
+        return true;
+    }
+
+    // 清空已完成的请求
+    void SubmitBatch::clear()
+    {
+        std::error_code ec;
+        if (flush(ec))
+            entries_.clear();
+    }
+
+    SubmitBatch::Entry& SubmitBatch::next_entry()
+    {
+        entries_.emplace_back();
+        Entry& entry = entries_.back();
+        entry.complete = &SubmitBatch::on_complete;
+        entry.batch = this;
+        return entry;
+    }
+
+    // 为连接和发送请求分配目标地址的存储，随请求一起保留到 clear() 或析构
+    sockaddr_storage& SubmitBatch::address_of(Entry& entry)
+    {
+        entry.address.reset(new sockaddr_storage());
+        return *entry.address;
+    }
+
+    // 记录结果，负的结果转换为错误码
+    void SubmitBatch::on_complete(IoOperation* op, int result, unsigned)
+    {
+        auto* entry = static_cast<Entry*>(op);
+        if (result < 0)
+            entry->result.error = std::error_code(-result, std::generic_category());
+        else
+            entry->result.bytes = static_cast<size_t>(result);
+        entry->in_flight = false;
+        --entry->batch->pending_;
+    }
+}
@@ -0,0 +1,183 @@
+#include "BufReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include "ByteSearch.h"
+
+namespace net
+{
+    BufReader::BufReader(TcpStream& stream, size_t capacity)
+        : stream_(stream), buffer_(new uint8_t[capacity]), capacity_(capacity) {}
+
+    ConstBuffer BufReader::buffered() const
+    {
+        return ConstBuffer(buffer_.get() + begin_, end_ - begin_);
+    }
+
+    // 预读数据但不消费
+    ConstBuffer BufReader::peek(size_t size, std::error_code& ec)
+    {
+        if (size > capacity_)
+        {
+            ec = std::make_error_code(std::errc::value_too_large);
+            return ConstBuffer();
+        }
+
+        while (end_ - begin_ < size && !eof_)
+        {
+            // 尾部放不下时先把未消费的数据移到开头
+            if (capacity_ - begin_ < size)
+                compact();
+            fill(ec);
+            if (ec)
+                return ConstBuffer();
+        }
+        return ConstBuffer(buffer_.get() + begin_, std::min(size, end_ - begin_));
+    }
+
+    // 消费缓冲区开头的数据
+    void BufReader::consume(size_t size)
+    {
+        begin_ += std::min(size, end_ - begin_);
+        scanned_ = std::max(scanned_, begin_);
+
+        // 数据全部消费后从头开始使用缓冲区，常见的请求/响应交替不需要搬移数据
+        if (begin_ == end_)
+        {
+            begin_ = 0;
+            end_ = 0;
+            scanned_ = 0;
+        }
+    }
+
+    // 读取直到分隔符
+    ConstBuffer BufReader::read_until(uint8_t delimiter, std::error_code& ec)
+    {
+        if (delimiter != scan_delimiter_)
+        {
+            scan_delimiter_ = delimiter;
+            scanned_ = begin_;
+        }
+
+        for (;;)
+        {
+            const uint8_t* found = find_byte(buffer_.get() + scanned_, end_ - scanned_, delimiter);
+            if (found)
+            {
+                size_t size = static_cast<size_t>(found - buffer_.get()) + 1 - begin_;
+                ConstBuffer frame(buffer_.get() + begin_, size);
+                consume(size);
+                return frame;
+            }
+            scanned_ = end_;
+
+            // 对端关闭连接，交出剩余的数据
+            if (eof_)
+            {
+                ConstBuffer rest = buffered();
+                consume(rest.size());
+                return rest;
+            }
+
+            if (end_ - begin_ == capacity_)
+            {
+                ec = std::make_error_code(std::errc::value_too_large);
+                return ConstBuffer();
+            }
+            fill(ec);
+            if (ec)
+                return ConstBuffer();
+        }
+    }
+
+    // 读取一行并去掉行尾
+    std::string_view BufReader::read_line(std::error_code& ec)
+    {
+        ConstBuffer line = read_until('\n', ec);
+        size_t size = line.size();
+        if (size > 0 && line.data()[size - 1] == '\n')
+        {
+            --size;
+            if (size > 0 && line.data()[size - 1] == '\r')
+                --size;
+        }
+        return std::string_view(reinterpret_cast<const char*>(line.data()), size);
+    }
+
+    // 读取到调用者的缓冲区
+    size_t BufReader::read(MutableBuffer buffer, std::error_code& ec)
+    {
+        if (begin_ == end_)
+        {
+            if (eof_)
+                return 0;
+
+            // 大块读取直接进入调用者的缓冲区，不经过内部缓冲区
+            if (buffer.size() >= capacity_)
+            {
+                size_t bytes_read = stream_.read(buffer, ec);
+                if (!ec && bytes_read == 0)
+                    eof_ = true;
+                return bytes_read;
+            }
+            fill(ec);
+            if (ec)
+                return 0;
+        }
+
+        size_t size = std::min(buffer.size(), end_ - begin_);
+        std::memcpy(buffer.data(), buffer_.get() + begin_, size);
+        consume(size);
+        return size;
+    }
+
+    // 从连接读取一次
+    size_t BufReader::fill(std::error_code& ec)
+    {
+        if (eof_)
+            return 0;
+        if (end_ == capacity_)
+        {
+            if (begin_ == 0)
+            {
+                ec = std::make_error_code(std::errc::value_too_large);
+                return 0;
+            }
+            compact();
+        }
+
+        size_t bytes_read = stream_.read(MutableBuffer(buffer_.get() + end_, capacity_ - end_), ec);
+        if (ec)
+            return 0;
+        if (bytes_read == 0)
+            eof_ = true;
+        end_ += bytes_read;
+        return bytes_read;
+    }
+
+    // 扩大缓冲区，未消费的数据搬到新缓冲区的开头
+    void BufReader::reserve(size_t capacity)
+    {
+        if (capacity <= capacity_)
+            return;
+
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[capacity]);
+        std::memcpy(buffer.get(), buffer_.get() + begin_, end_ - begin_);
+        buffer_ = std::move(buffer);
+        capacity_ = capacity;
+        scanned_ -= begin_;
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    // 把未消费的数据移到缓冲区开头
+    void BufReader::compact()
+    {
+        if (begin_ == 0)
+            return;
+        std::memmove(buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+        scanned_ -= begin_;
+        end_ -= begin_;
+        begin_ = 0;
+    }
+}
@@ -0,0 +1,104 @@
+#include "BufWriter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace net
+{
+    BufWriter::BufWriter(TcpStream& stream, size_t capacity)
+        : stream_(stream), buffer_(new uint8_t[capacity]), capacity_(capacity) {}
+
+    BufWriter::~BufWriter()
+    {
+        std::error_code ec;
+        flush(ec);
+    }
+
+    // 追加数据
+    size_t BufWriter::write(ConstBuffer data, std::error_code& ec)
+    {
+        // 放得下时只拷贝进缓冲区
+        if (data.size() <= capacity_ - size_)
+        {
+            std::memcpy(buffer_.get() + size_, data.data(), data.size());
+            size_ += data.size();
+            return data.size();
+        }
+
+        // 放不下但小于容量：先写出已缓冲的数据
+        if (data.size() < capacity_)
+        {
+            if (!flush(ec))
+                return 0;
+            std::memcpy(buffer_.get(), data.data(), data.size());
+            size_ = data.size();
+            return data.size();
+        }
+
+        // 大块数据与已缓冲的数据一起聚集写出
+        ConstBuffer parts[2] = {ConstBuffer(buffer_.get(), size_), data};
+        size_t index = size_ > 0 ? 0 : 1;
+        while (index < 2)
+        {
+            size_t bytes_written = stream_.writev(parts + index, 2 - index, ec);
+            if (!ec && bytes_written == 0)
+                ec = std::make_error_code(std::errc::broken_pipe);
+            if (ec)
+                break;
+
+            while (index < 2 && bytes_written >= parts[index].size())
+            {
+                bytes_written -= parts[index].size();
+                parts[index] = ConstBuffer();
+                ++index;
+            }
+            if (index < 2)
+                parts[index] = parts[index].advance(bytes_written);
+        }
+
+        // 出错时保留缓冲区中尚未写出的部分
+        if (index == 0)
+        {
+            std::memmove(buffer_.get(), parts[0].data(), parts[0].size());
+            size_ = parts[0].size();
+            return 0;
+        }
+        size_ = 0;
+        return index < 2 ? data.size() - parts[1].size() : data.size();
+    }
+
+    // 在缓冲区中预留空间
+    MutableBuffer BufWriter::prepare(size_t size, std::error_code& ec)
+    {
+        if (size > capacity_)
+        {
+            ec = std::make_error_code(std::errc::value_too_large);
+            return MutableBuffer();
+        }
+        if (size > capacity_ - size_ && !flush(ec))
+            return MutableBuffer();
+        return MutableBuffer(buffer_.get() + size_, capacity_ - size_);
+    }
+
+    void BufWriter::commit(size_t size)
+    {
+        size_ += std::min(size, capacity_ - size_);
+    }
+
+    // 写出全部缓冲的数据
+    bool BufWriter::flush(std::error_code& ec)
+    {
+        if (size_ == 0)
+            return true;
+
+        size_t written = stream_.write_all(ConstBuffer(buffer_.get(), size_), ec);
+        if (written < size_)
+        {
+            std::memmove(buffer_.get(), buffer_.get() + written, size_ - written);
+            size_ -= written;
+            return false;
+        }
+        size_ = 0;
+        return true;
+    }
+}
@@ -0,0 +1,116 @@
+#include "ByteSearch.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NET_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// GCC/Clang 可以只为单个函数启用 AVX2，再在运行时按 CPU 支持选择；MSVC 需要整体以 /arch:AVX2 编译
+#if defined(NET_HAVE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define NET_HAVE_AVX2 1
+#define NET_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(NET_HAVE_SSE2) && defined(__AVX2__)
+#define NET_HAVE_AVX2 1
+#define NET_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace net
+{
+    namespace
+    {
+        using FindByte = const uint8_t* (*)(const uint8_t* data, size_t size, uint8_t value);
+
+        const uint8_t* find_byte_scalar(const uint8_t* data, size_t size, uint8_t value)
+        {
+            return static_cast<const uint8_t*>(std::memchr(data, value, size));
+        }
+
+#if defined(NET_HAVE_SSE2)
+        // 比较结果掩码中最低的置位，即第一个匹配字节的位置
+        inline unsigned first_match(uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        const uint8_t* find_byte_sse2(const uint8_t* data, size_t size, uint8_t value)
+        {
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+                if (mask != 0)
+                    return data + i + first_match(mask);
+            }
+            return find_byte_scalar(data + i, size - i, value);
+        }
+#endif
+
+#if defined(NET_HAVE_AVX2)
+        // 每轮比较两个 32 字节块，合并后只做一次分支判断
+        NET_AVX2_TARGET
+        const uint8_t* find_byte_avx2(const uint8_t* data, size_t size, uint8_t value)
+        {
+            const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+            size_t i = 0;
+            for (; i + 64 <= size; i += 64)
+            {
+                __m256i low = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+                __m256i high = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32)), needle);
+                if (_mm256_movemask_epi8(_mm256_or_si256(low, high)) != 0)
+                {
+                    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(low));
+                    if (mask != 0)
+                        return data + i + first_match(mask);
+                    return data + i + 32 + first_match(static_cast<uint32_t>(_mm256_movemask_epi8(high)));
+                }
+            }
+            for (; i + 32 <= size; i += 32)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+                if (mask != 0)
+                    return data + i + first_match(mask);
+            }
+            return find_byte_sse2(data + i, size - i, value);
+        }
+#endif
+
+        // 首次调用时按 CPU 支持选择实现
+        FindByte select_find_byte()
+        {
+#if defined(NET_HAVE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+            if (__builtin_cpu_supports("avx2"))
+                return &find_byte_avx2;
+#elif defined(NET_HAVE_AVX2)
+            return &find_byte_avx2;
+#endif
+#if defined(NET_HAVE_SSE2)
+            return &find_byte_sse2;
+#else
+            return &find_byte_scalar;
+#endif
+        }
+    }
+
+    const uint8_t* find_byte(const uint8_t* data, size_t size, uint8_t value)
+    {
+        static const FindByte implementation = select_find_byte();
+        return implementation(data, size, value);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef BYTE_SEARCH_H
+#define BYTE_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace net
+{
+    // 在 [data, data + size) 中查找第一个等于 value 的字节，找不到时返回 nullptr
+    // x86 上按 CPU 支持选择 AVX2（每次 64 字节）或 SSE2（每次 16 字节），其他平台使用 memchr
+    const uint8_t* find_byte(const uint8_t* data, size_t size, uint8_t value);
+
+} // namespace net
+
+#endif // BYTE_SEARCH_H
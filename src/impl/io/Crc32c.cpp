@@ -0,0 +1,111 @@
+#include "Crc32c.h"
+
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NET_HAVE_SSE42 1
+#define NET_SSE42_TARGET __attribute__((target("sse4.2")))
+#include <nmmintrin.h>
+#elif defined(_MSC_VER) && defined(__AVX__)
+#define NET_HAVE_SSE42 1
+#define NET_SSE42_TARGET
+#include <nmmintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace net
+{
+    namespace
+    {
+        using Crc32c = uint32_t (*)(const uint8_t* data, size_t size, uint32_t crc);
+
+        constexpr uint32_t kPolynomial = 0x82F63B78; // 0x1EDC6F41 的位反转形式
+
+        struct Table
+        {
+            uint32_t entries[256];
+
+            Table()
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+                    entries[i] = crc;
+                }
+            }
+        };
+
+        uint32_t crc32c_table(const uint8_t* data, size_t size, uint32_t crc)
+        {
+            static const Table table;
+            for (size_t i = 0; i < size; ++i)
+                crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return crc;
+        }
+
+#if defined(NET_HAVE_SSE42)
+        NET_SSE42_TARGET
+        uint32_t crc32c_sse42(const uint8_t* data, size_t size, uint32_t crc)
+        {
+            size_t i = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+            uint64_t crc64 = crc;
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+            }
+            crc = static_cast<uint32_t>(crc64);
+#endif
+            for (; i < size; ++i)
+                crc = _mm_crc32_u8(crc, data[i]);
+            return crc;
+        }
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+        uint32_t crc32c_arm(const uint8_t* data, size_t size, uint32_t crc)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                crc = __crc32cd(crc, word);
+            }
+            for (; i < size; ++i)
+                crc = __crc32cb(crc, data[i]);
+            return crc;
+        }
+#endif
+
+        // 首次调用时按 CPU 支持选择实现
+        Crc32c select_crc32c()
+        {
+#if defined(NET_HAVE_SSE42) && (defined(__GNUC__) || defined(__clang__))
+            if (__builtin_cpu_supports("sse4.2"))
+                return &crc32c_sse42;
+#elif defined(NET_HAVE_SSE42)
+            return &crc32c_sse42;
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+            return &crc32c_arm;
+#else
+            return &crc32c_table;
+#endif
+        }
+    }
+
+    // 按惯例对输入和输出的 CRC 取反，分段计算时直接传入上一段的结果
+    uint32_t crc32c(const uint8_t* data, size_t size, uint32_t crc)
+    {
+        static const Crc32c implementation = select_crc32c();
+        return ~implementation(data, size, ~crc);
+    }
+}
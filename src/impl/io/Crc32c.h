@@ -0,0 +1,15 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace net
+{
+    // CRC32C（Castagnoli 多项式）校验和，crc 为前一段数据的结果，可以分段计算
+    // x86 上支持 SSE4.2 时使用 crc32 指令，ARMv8 上使用 CRC 扩展，其他情况查表
+    uint32_t crc32c(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+} // namespace net
+
+#endif // CRC32C_H
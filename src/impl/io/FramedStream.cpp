@@ -0,0 +1,238 @@
+#include "FramedStream.h"
+
+#include <algorithm>
+#include <limits>
+#include "Crc32c.h"
+
+namespace net
+{
+    namespace
+    {
+        // 把帧长度上限限制在长度字段能表示的范围内
+        FrameOptions normalize(FrameOptions options)
+        {
+            size_t limit = std::numeric_limits<uint32_t>::max();
+            if (options.prefix == LengthPrefix::U16)
+                limit = std::numeric_limits<uint16_t>::max();
+            options.max_frame_size = std::min(options.max_frame_size, limit);
+
+            // 接收缓冲区至少要放得下一个帧头，之后按帧头声明的长度扩大
+            options.read_buffer_size = std::max(options.read_buffer_size, FramedStream::kMaxHeaderSize);
+            return options;
+        }
+    }
+
+    FramedStream::FramedStream(TcpStream& stream, const FrameOptions& options)
+        : options_(normalize(options)),
+          reader_(stream, options_.read_buffer_size),
+          writer_(stream, options_.write_buffer_size) {}
+
+    // 解码缓冲区中所有完整的帧
+    size_t FramedStream::read_frames(std::vector<ConstBuffer>& frames, std::error_code& ec)
+    {
+        for (;;)
+        {
+            ConstBuffer data = reader_.buffered();
+            size_t offset = 0;
+            size_t count = 0;
+            size_t needed = 0;
+            ConstBuffer frame;
+            std::error_code decode_ec;
+            Decode result;
+            while ((result = decode(data, offset, frame, needed, decode_ec)) == Decode::Frame)
+            {
+                frames.push_back(frame);
+                ++count;
+            }
+
+            // 视图指向的数据在下一次读取之前不会被覆盖，可以先消费
+            // 出错的帧留在缓冲区中，先交出已解码的帧，下一次调用时再报告错误
+            reader_.consume(offset);
+            if (count > 0)
+                return count;
+            if (result == Decode::Error)
+            {
+                ec = decode_ec;
+                return 0;
+            }
+            if (!fill(needed, ec))
+                return 0;
+        }
+    }
+
+    // 读取一个帧
+    ConstBuffer FramedStream::read_frame(std::error_code& ec)
+    {
+        for (;;)
+        {
+            size_t offset = 0;
+            size_t needed = 0;
+            ConstBuffer frame;
+            Decode result = decode(reader_.buffered(), offset, frame, needed, ec);
+            if (result == Decode::Frame)
+            {
+                reader_.consume(offset);
+                return frame;
+            }
+            if (result == Decode::Error || !fill(needed, ec))
+                return ConstBuffer();
+        }
+    }
+
+    // 编码并打包一个帧
+    bool FramedStream::write_frame(ConstBuffer payload, std::error_code& ec)
+    {
+        if (payload.size() > options_.max_frame_size)
+        {
+            ec = std::make_error_code(std::errc::message_size);
+            return false;
+        }
+
+        uint8_t header[kMaxHeaderSize];
+        size_t header_size = encode_length(payload.size(), header);
+        writer_.write(ConstBuffer(header, header_size), ec);
+        if (ec)
+            return false;
+        writer_.write(payload, ec);
+        if (ec)
+            return false;
+
+        if (options_.crc32c)
+        {
+            uint32_t crc = crc32c(payload.data(), payload.size());
+            uint8_t trailer[kChecksumSize] = {
+                static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8),
+                static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 24)};
+            writer_.write(ConstBuffer(trailer, sizeof(trailer)), ec);
+            if (ec)
+                return false;
+        }
+        return true;
+    }
+
+    bool FramedStream::flush(std::error_code& ec)
+    {
+        return writer_.flush(ec);
+    }
+
+    // 缓冲区中没有完整的帧时再读取一次，连接关闭或出错时返回 false
+    // 只有帧头声明的帧大于当前容量时才扩大缓冲区，小帧的连接不为 max_frame_size 预留内存
+    bool FramedStream::fill(size_t needed, std::error_code& ec)
+    {
+        if (needed > reader_.capacity())
+            reader_.reserve(needed);
+
+        size_t bytes_read = reader_.fill(ec);
+        if (ec)
+            return false;
+        if (bytes_read == 0)
+        {
+            // 关闭时还有不完整的帧
+            if (!reader_.eof())
+                ec = std::make_error_code(std::errc::connection_reset);
+            return false;
+        }
+        return true;
+    }
+
+    // 解码一个帧：先解析长度，数据不完整时等待更多数据
+    FramedStream::Decode FramedStream::decode(ConstBuffer data, size_t& offset, ConstBuffer& frame, size_t& needed, std::error_code& ec) const
+    {
+        needed = 0;
+        const uint8_t* p = data.data() + offset;
+        size_t available = data.size() - offset;
+        uint64_t length = 0;
+        size_t header_size = 0;
+
+        switch (options_.prefix)
+        {
+        case LengthPrefix::U16:
+            if (available < 2)
+                return Decode::Incomplete;
+            length = (uint64_t(p[0]) << 8) | p[1];
+            header_size = 2;
+            break;
+        case LengthPrefix::U32:
+            if (available < 4)
+                return Decode::Incomplete;
+            length = (uint64_t(p[0]) << 24) | (uint64_t(p[1]) << 16) | (uint64_t(p[2]) << 8) | p[3];
+            header_size = 4;
+            break;
+        case LengthPrefix::Varint:
+            for (unsigned shift = 0;; shift += 7)
+            {
+                if (header_size == available)
+                    return Decode::Incomplete;
+                if (header_size == kMaxHeaderSize)
+                {
+                    ec = std::make_error_code(std::errc::bad_message);
+                    return Decode::Error;
+                }
+                uint8_t byte = p[header_size++];
+                length |= uint64_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    break;
+            }
+            break;
+        }
+
+        if (length > options_.max_frame_size)
+        {
+            ec = std::make_error_code(std::errc::message_size);
+            return Decode::Error;
+        }
+
+        size_t checksum_size = options_.crc32c ? kChecksumSize : 0;
+        if (available < header_size + length + checksum_size)
+        {
+            needed = header_size + length + checksum_size;
+            return Decode::Incomplete;
+        }
+
+        const uint8_t* payload = p + header_size;
+        if (options_.crc32c)
+        {
+            const uint8_t* trailer = payload + length;
+            uint32_t expected = uint32_t(trailer[0]) | (uint32_t(trailer[1]) << 8) |
+                                (uint32_t(trailer[2]) << 16) | (uint32_t(trailer[3]) << 24);
+            if (crc32c(payload, length) != expected)
+            {
+                ec = std::make_error_code(std::errc::bad_message);
+                return Decode::Error;
+            }
+        }
+
+        frame = ConstBuffer(payload, length);
+        offset += header_size + length + checksum_size;
+        return Decode::Frame;
+    }
+
+    // 编码长度字段
+    size_t FramedStream::encode_length(size_t length, uint8_t* header) const
+    {
+        switch (options_.prefix)
+        {
+        case LengthPrefix::U16:
+            header[0] = static_cast<uint8_t>(length >> 8);
+            header[1] = static_cast<uint8_t>(length);
+            return 2;
+        case LengthPrefix::U32:
+            header[0] = static_cast<uint8_t>(length >> 24);
+            header[1] = static_cast<uint8_t>(length >> 16);
+            header[2] = static_cast<uint8_t>(length >> 8);
+            header[3] = static_cast<uint8_t>(length);
+            return 4;
+        case LengthPrefix::Varint:
+            break;
+        }
+
+        size_t size = 0;
+        while (length >= 0x80)
+        {
+            header[size++] = static_cast<uint8_t>(length | 0x80);
+            length >>= 7;
+        }
+        header[size++] = static_cast<uint8_t>(length);
+        return size;
+    }
+}
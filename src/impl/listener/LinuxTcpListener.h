@@ -8,9 +8,14 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <cstring>
+#include <chrono>
 #include <stdexcept>
+#include <cassert>
 #include <system_error>
+#include <deque>
 #include "TcpListener.h"
+#include "LinuxIoContext.h"
+#include "LinuxTcpStream.h"
 
 namespace net
 {
@@ -18,81 +23,76 @@ namespace net
     class TcpListener::Impl
     {
     public:
-        Impl() : socket_fd_(-1), ring_(nullptr) {}
-        Impl(int socket_fd, io_uring *ring) : socket_fd_(socket_fd), ring_(ring) {}
+        Impl() : Impl(-1) {}
+        Impl(int socket_fd) : socket_fd_(socket_fd)
+        {
+            accept_op_.complete = &Impl::on_accept;
+            accept_op_.owner = this;
+        }
 
+        // 启用了 multishot accept 的监听者必须在所属线程上销毁
         ~Impl()
         {
+            assert(!multishot_armed_ || multishot_context_->impl_->is_current());
+            cancel_multishot();
+            for (int fd : accept_queue_)
+                close(fd);
             if (socket_fd_ >= 0)
                 close(socket_fd_);
-            if (ring_)
-            {
-                io_uring_queue_exit(ring_);
-                delete ring_;
-            }
         }
 
-        bool bind(const std::string &address, int port, std::error_code &ec)
+        bool bind(const std::string &address, int port, const ListenOptions &options, std::error_code &ec)
         {
-            // 创建 io_uring 实例
-            auto *ring = new io_uring();
-            if (io_uring_queue_init(32, ring, 0) < 0)
+            // 先解析地址，监听套接字的地址族跟随绑定地址
+            std::optional<SocketAddr> local = SocketAddr::parse(address, port);
+            if (!local)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                delete ring;
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
+            sockaddr_storage local_addr = {};
+            socklen_t addr_len = local->to_sockaddr(local_addr);
 
             // 创建 socket
-            int socket_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            int socket_fd = ::socket(local_addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK, 0);
             if (socket_fd < 0)
             {
-                ec = std::make_error_code(std::errc::address_family_not_supported);
-                io_uring_queue_exit(ring);
-                delete ring;
+                ec = std::error_code(errno, std::generic_category());
                 return false;
             }
 
             int opt = 1;
             setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 
-            sockaddr_in local_addr = {};
-            local_addr.sin_family = AF_INET;
-            local_addr.sin_port = htons(port);
-            if (inet_pton(AF_INET, address.c_str(), &local_addr.sin_addr) <= 0)
+            // 同一端口上的多个监听者由内核分配连接，各线程的 accept 互不竞争
+            if (options.reuse_port && setsockopt(socket_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0)
             {
-                ec = std::make_error_code(std::errc::invalid_argument);
+                ec = std::error_code(errno, std::generic_category());
                 close(socket_fd);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
-            if (::bind(socket_fd_, reinterpret_cast<sockaddr *>(&local_addr), sizeof(local_addr)) < 0)
+            if (::bind(socket_fd, reinterpret_cast<sockaddr *>(&local_addr), addr_len) < 0)
             {
-                ec = std::make_error_code(std::errc::address_in_use);
+                ec = std::error_code(errno, std::generic_category());
                 close(socket_fd);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
-            if (::listen(socket_fd_, SOMAXCONN) < 0)
+            if (::listen(socket_fd, SOMAXCONN) < 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::error_code(errno, std::generic_category());
                 close(socket_fd);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
-            // 成功时，保存ring，并返回true
+            // 成功时保存 socket，并返回true
             socket_fd_ = socket_fd;
-            ring_ = ring;
             return true;
         }
 
-        std::optional<TcpStream> accept(std::error_code &ec)
+        // 接受连接，peer 返回对端地址
+        std::optional<TcpStream> accept(SocketAddr &peer, std::error_code &ec)
         {
             if (socket_fd_ < 0)
             {
@@ -100,47 +100,214 @@ namespace net
                 return std::nullopt;
             }
 
-            sockaddr_in client_addr = {};
+            // 已启用多路 accept 时从内部队列取连接
+            if (multishot_armed_ || !accept_queue_.empty())
+            {
+                if (!wait_accepted(ec))
+                    return std::nullopt;
+                int client_socket_fd = accept_queue_.front();
+                accept_queue_.pop_front();
+
+                // multishot accept 不返回对端地址，需要时再查询
+                sockaddr_storage client_addr = {};
+                socklen_t addr_len = sizeof(client_addr);
+                if (getpeername(client_socket_fd, reinterpret_cast<sockaddr *>(&client_addr), &addr_len) == 0)
+                    peer = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&client_addr), addr_len);
+                else
+                    peer = SocketAddr();
+                return TcpStream(client_socket_fd);
+            }
+
+            sockaddr_storage client_addr = {};
             socklen_t addr_len = sizeof(client_addr);
 
             // 使用 io_uring 提交 accept 请求
-            io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = context.get_sqe(accept_timeout_, ec);
+            if (!sqe)
+                return std::nullopt;
             io_uring_prep_accept(sqe, socket_fd_, reinterpret_cast<sockaddr *>(&client_addr), &addr_len, 0);
-            io_uring_submit(ring_);
 
             // 等待 accept 完成
-            io_uring_cqe *cqe;
-            if (io_uring_wait_cqe(ring_, &cqe) < 0)
+            SyncOperation op;
+            if (!context.wait(sqe, op, accept_timeout_, ec))
+                return std::nullopt;
+
+            // 保留内核的错误码，调用者据此区分可重试的 ECONNABORTED、需要退避的 EMFILE/ENFILE
+            // 和监听者已关闭时的 EINVAL；链接的超时到期时为 ETIMEDOUT，即 timed_out
+            if (op.result < 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::error_code(-op.result, std::generic_category());
                 return std::nullopt;
             }
 
-            if (cqe->res < 0)
+            peer = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&client_addr), addr_len);
+
+            // 新连接与监听者共享同一个线程的 io_uring
+            return TcpStream(op.result);
+        }
+
+        // 直接 accept：新连接由内核放入固定文件表的槽位，不经过进程的文件描述符表
+        // 得到的连接只能在当前线程上使用
+        std::optional<TcpStream> accept_direct(std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                io_uring_cqe_seen(ring_, cqe);
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return std::nullopt;
             }
 
-            int client_socket_fd = cqe->res;
-            io_uring_cqe_seen(ring_, cqe);
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int slot = context.allocate_file_slot(ec);
+            if (slot < 0)
+                return std::nullopt;
 
-            // 创建新的 io_uring 实例用于 TcpStream
-            auto *stream_ring = new io_uring();
-            if (io_uring_queue_init(32, stream_ring, 0) < 0)
+            io_uring_sqe *sqe = context.get_sqe(accept_timeout_, ec);
+            if (!sqe)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                close(client_socket_fd);
+                context.release_file_slot(slot);
                 return std::nullopt;
             }
+            io_uring_prep_accept_direct(sqe, socket_fd_, nullptr, nullptr, 0, slot);
+
+            // 等待 accept 完成
+            SyncOperation op;
+            if (!context.wait(sqe, op, accept_timeout_, ec) || op.result < 0)
+            {
+                if (!ec)
+                    ec = std::error_code(-op.result, std::generic_category());
+                context.release_file_slot(slot);
+                return std::nullopt;
+            }
+
+            TcpStream stream;
+            stream.impl_->adopt_fixed(slot, &context);
+            return stream;
+        }
+
+        // 批量接受连接：首次调用时提交一个 multishot accept，之后内核持续把新连接
+        // 投递到完成队列，这里只负责从内部队列中取出最多 max 个
+        size_t accept_batch(std::vector<TcpStream> &streams, size_t max, std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (max == 0)
+                return 0;
+
+            if (!wait_accepted(ec))
+                return 0;
+
+            size_t count = 0;
+            while (count < max && !accept_queue_.empty())
+            {
+                streams.emplace_back(accept_queue_.front());
+                accept_queue_.pop_front();
+                ++count;
+            }
+            return count;
+        }
+
+        void set_accept_timeout(std::chrono::milliseconds timeout) { accept_timeout_ = timeout; }
+
+        // 异步 accept：提交后立即返回，完成时新连接的描述符交给 op
+        bool start_accept(IoOperation *op, std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
 
-            return TcpStream(client_socket_fd, stream_ring);
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_accept(sqe, socket_fd_, nullptr, nullptr, 0);
+            context.prepare(sqe, op);
+            return true;
         }
 
     private:
+        struct AcceptOperation : IoOperation
+        {
+            Impl *owner = nullptr;
+        };
+
+        // multishot accept 的完成回调，每个新连接产生一个完成事件
+        static void on_accept(IoOperation *op, int result, unsigned flags)
+        {
+            Impl *self = static_cast<AcceptOperation *>(op)->owner;
+            if (result >= 0)
+                self->accept_queue_.push_back(result);
+            else if (result != -ECANCELED)
+                self->accept_error_ = std::error_code(-result, std::generic_category());
+
+            // 没有 IORING_CQE_F_MORE 表示内核已终止该请求，下次等待时重新提交
+            if (!(flags & IORING_CQE_F_MORE))
+                self->multishot_armed_ = false;
+        }
+
+        bool arm_multishot(std::error_code &ec)
+        {
+            IoContext &context = IoContext::current();
+            io_uring_sqe *sqe = context.impl_->get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_multishot_accept(sqe, socket_fd_, nullptr, nullptr, 0);
+            context.impl_->prepare(sqe, &accept_op_);
+            multishot_context_ = &context;
+            multishot_armed_ = true;
+            return true;
+        }
+
+        // 驱动事件循环直到队列中至少有一个连接
+        bool wait_accepted(std::error_code &ec)
+        {
+            // multishot 请求属于提交它的线程的 io_uring，只能在该线程上等待
+            if (multishot_armed_ && multishot_context_ != &IoContext::current())
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
+                return false;
+            }
+
+            while (accept_queue_.empty())
+            {
+                if (accept_error_)
+                {
+                    ec = accept_error_;
+                    accept_error_.clear();
+                    return false;
+                }
+                if (!multishot_armed_ && !arm_multishot(ec))
+                    return false;
+
+                // multishot 请求不能链接超时，accept 期限由等待本身计时
+                auto ready = [this] { return !accept_queue_.empty() || !multishot_armed_ || accept_error_; };
+                if (!multishot_context_->impl_->wait_until(ready, accept_timeout_, ec))
+                    return false;
+            }
+            return true;
+        }
+
+        // 取消仍在进行的 multishot accept，并等待其最后一个完成事件
+        void cancel_multishot()
+        {
+            if (!multishot_armed_)
+                return;
+
+            multishot_context_->impl_->cancel(&accept_op_, [this] { return !multishot_armed_; });
+        }
+
         int socket_fd_ = -1;
-        io_uring *ring_ = nullptr;
+        AcceptOperation accept_op_;
+        std::deque<int> accept_queue_;
+        std::error_code accept_error_;
+        IoContext *multishot_context_ = nullptr;
+        bool multishot_armed_ = false;
+        std::chrono::milliseconds accept_timeout_{0};
     };
 
 } // namespace net
@@ -27,37 +27,37 @@ namespace net
         }
 
         // 绑定地址和端口
-        bool bind(const std::string &address, int port, std::error_code &ec)
+        bool bind(const std::string &address, int port, const ListenOptions &options, std::error_code &ec)
         {
-            listener_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
-            if (listener_fd_ == -1)
+            // "*" 表示任意地址；监听套接字的地址族跟随绑定地址
+            std::optional<SocketAddr> local = SocketAddr::parse(address == "*" ? "0.0.0.0" : address, port);
+            if (!local)
             {
-                ec.assign(errno, std::system_category());
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
+            sockaddr_storage server_addr{};
+            socklen_t addr_len = static_cast<socklen_t>(local->to_sockaddr(server_addr));
 
-            sockaddr_in server_addr{};
-            server_addr.sin_family = AF_INET;
-            server_addr.sin_port = htons(port);
-
-            // 处理地址
-            if (address == "0.0.0.0" || address == "*")
+            listener_fd_ = ::socket(server_addr.ss_family, SOCK_STREAM, 0);
+            if (listener_fd_ == -1)
             {
-                server_addr.sin_addr.s_addr = INADDR_ANY; // 任意地址
+                ec.assign(errno, std::system_category());
+                return false;
             }
-            else
+
+            // 该平台的 SO_REUSEPORT 只允许共享端口，不在监听者之间均衡分配连接
+            int opt = 1;
+            if (options.reuse_port && setsockopt(listener_fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) == -1)
             {
-                if (::inet_pton(AF_INET, address.c_str(), &server_addr.sin_addr) <= 0)
-                {
-                    ec.assign(errno, std::system_category());
-                    close(listener_fd_);
-                    listener_fd_ = -1;
-                    return false;
-                }
+                ec.assign(errno, std::system_category());
+                close(listener_fd_);
+                listener_fd_ = -1;
+                return false;
             }
 
             // 绑定到指定的地址和端口
-            if (::bind(listener_fd_, reinterpret_cast<sockaddr *>(&server_addr), sizeof(server_addr)) == -1)
+            if (::bind(listener_fd_, reinterpret_cast<sockaddr *>(&server_addr), addr_len) == -1)
             {
                 ec.assign(errno, std::system_category());
                 close(listener_fd_);
@@ -77,22 +77,63 @@ namespace net
             return true;
         }
 
-        // 接受一个新的连接
-        std::optional<TcpStream> accept(std::error_code &ec)
+        // 接受一个新的连接，peer 返回对端地址
+        std::optional<TcpStream> accept(SocketAddr &peer, std::error_code &ec)
         {
-            sockaddr_in client_addr{};
+            sockaddr_storage client_addr{};
             socklen_t client_len = sizeof(client_addr);
 
             int client_fd = ::accept(listener_fd_, reinterpret_cast<sockaddr *>(&client_addr), &client_len);
             if (client_fd == -1)
             {
-                ec.assign(errno, std::system_category());
+                // 超过 SO_RCVTIMEO 时 accept 返回 EAGAIN
+                if (errno == EAGAIN)
+                    ec = std::make_error_code(std::errc::timed_out);
+                else
+                    ec.assign(errno, std::system_category());
                 return std::nullopt;
             }
 
+            peer = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&client_addr), client_len);
             return TcpStream(client_fd); // 假设 TcpStream 可以直接通过文件描述符创建
         }
 
+        // 该平台没有固定文件表，退化为普通 accept
+        std::optional<TcpStream> accept_direct(std::error_code &ec)
+        {
+            SocketAddr peer;
+            return accept(peer, ec);
+        }
+
+        // 该平台没有 multishot accept，每次只接受一个连接
+        size_t accept_batch(std::vector<TcpStream> &streams, size_t max, std::error_code &ec)
+        {
+            if (max == 0)
+                return 0;
+            SocketAddr peer;
+            auto stream = accept(peer, ec);
+            if (!stream)
+                return 0;
+            streams.push_back(std::move(*stream));
+            return 1;
+        }
+
+        // 该平台的 accept 同样遵守监听套接字的 SO_RCVTIMEO
+        void set_accept_timeout(std::chrono::milliseconds timeout)
+        {
+            timeval tv = {};
+            tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+            tv.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+            setsockopt(listener_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_accept(IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
     private:
         int listener_fd_;
     };
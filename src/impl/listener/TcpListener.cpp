@@ -39,9 +39,14 @@ namespace net
 
     // 绑定地址和端口
     std::optional<TcpListener> TcpListener::bind(const std::string& address, int port, std::error_code& ec)
+    {
+        return bind(address, port, ListenOptions(), ec);
+    }
+
+    std::optional<TcpListener> TcpListener::bind(const std::string& address, int port, const ListenOptions& options, std::error_code& ec)
     {
         TcpListener listener;
-        if (listener.impl_->bind(address, port, ec))
+        if (listener.impl_->bind(address, port, options, ec))
         {
             return listener;
         }
@@ -50,12 +55,58 @@ namespace net
 
     // 接受连接
     std::optional<TcpStream> TcpListener::accept(std::error_code& ec)
+    {
+        SocketAddr peer;
+        return accept(peer, ec);
+    }
+
+    std::optional<TcpStream> TcpListener::accept(SocketAddr& peer, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return std::nullopt;
+        }
+        return impl_->accept(peer, ec);
+    }
+
+    // 直接接受连接到固定文件表
+    std::optional<TcpStream> TcpListener::accept_direct(std::error_code& ec)
     {
         if (!impl_)
         {
             ec = std::make_error_code(std::errc::bad_file_descriptor);
             return std::nullopt;
         }
-        return impl_->accept(ec);
+        return impl_->accept_direct(ec);
+    }
+
+    // 批量接受连接
+    size_t TcpListener::accept_batch(std::vector<TcpStream>& streams, size_t max, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->accept_batch(streams, max, ec);
+    }
+
+    // 设置 accept 期限
+    void TcpListener::set_accept_timeout(std::chrono::milliseconds timeout)
+    {
+        if (impl_)
+            impl_->set_accept_timeout(timeout);
+    }
+
+    // 提交异步 accept
+    bool TcpListener::start_accept(IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_accept(op, ec);
     }
 }
\ No newline at end of file
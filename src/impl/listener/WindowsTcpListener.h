@@ -45,8 +45,28 @@ namespace net
         }
 
         // 绑定地址和端口
-        bool bind(const std::string& address, int port, std::error_code& ec)
+        bool bind(const std::string& address, int port, const ListenOptions& options, std::error_code& ec)
         {
+            // 该平台没有 SO_REUSEPORT
+            if (options.reuse_port)
+            {
+                ec = std::make_error_code(std::errc::operation_not_supported);
+                return false;
+            }
+
+            // AcceptEx 的地址缓冲按 sockaddr_in 分配，该平台只监听 IPv4 地址
+            std::optional<SocketAddr> local = SocketAddr::parse(address, port);
+            if (!local)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            if (local->family() != SocketAddr::Family::V4)
+            {
+                ec = std::make_error_code(std::errc::address_family_not_supported);
+                return false;
+            }
+
             WSADATA wsaData;
             if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
             {
@@ -122,8 +142,8 @@ namespace net
             return true;
         }
 
-        // 接受连接
-        std::optional<TcpStream> accept(std::error_code& ec)
+        // 接受连接，peer 返回对端地址
+        std::optional<TcpStream> accept(SocketAddr& peer, std::error_code& ec)
         {
             if (listenSocket_ == INVALID_SOCKET)
             {
@@ -169,7 +189,19 @@ namespace net
             DWORD bytesTransferred;
             ULONG_PTR completionKey;
             LPOVERLAPPED pOverlapped;
-            BOOL success = GetQueuedCompletionStatus(iocpHandle_, &bytesTransferred, &completionKey, &pOverlapped, INFINITE);
+            DWORD wait = acceptTimeout_.count() > 0 ? static_cast<DWORD>(acceptTimeout_.count()) : INFINITE;
+            BOOL success = GetQueuedCompletionStatus(iocpHandle_, &bytesTransferred, &completionKey, &pOverlapped, wait);
+
+            // 超时后取消 AcceptEx，等它的完成包出队后才能释放 overlapped
+            if (!success && pOverlapped == nullptr && GetLastError() == WAIT_TIMEOUT)
+            {
+                CancelIoEx(reinterpret_cast<HANDLE>(listenSocket_), &overlapped->overlapped);
+                GetQueuedCompletionStatus(iocpHandle_, &bytesTransferred, &completionKey, &pOverlapped, INFINITE);
+                ec = std::make_error_code(std::errc::timed_out);
+                closesocket(clientSocket);
+                delete overlapped;
+                return std::nullopt;
+            }
 
             if (!success)
             {
@@ -184,13 +216,51 @@ namespace net
             clientSocket = overlapped->clientSocket;
             delete overlapped;
 
+            // AcceptEx 把双方地址写在缓冲区中
+            sockaddr* localAddr = nullptr;
+            sockaddr* remoteAddr = nullptr;
+            int localLen = 0;
+            int remoteLen = 0;
+            GetAcceptExSockaddrs(buffer.data(), 0, addrLen, addrLen, &localAddr, &localLen, &remoteAddr, &remoteLen);
+            peer = SocketAddr::from_sockaddr(remoteAddr, remoteLen);
+
             // 如果接收到连接，返回 TcpStream
             return TcpStream(clientSocket);
         }
 
+        // 该平台没有固定文件表，退化为普通 accept
+        std::optional<TcpStream> accept_direct(std::error_code& ec)
+        {
+            SocketAddr peer;
+            return accept(peer, ec);
+        }
+
+        // 该平台没有 multishot accept，每次只接受一个连接
+        size_t accept_batch(std::vector<TcpStream>& streams, size_t max, std::error_code& ec)
+        {
+            if (max == 0)
+                return 0;
+            SocketAddr peer;
+            auto stream = accept(peer, ec);
+            if (!stream)
+                return 0;
+            streams.push_back(std::move(*stream));
+            return 1;
+        }
+
+        void set_accept_timeout(std::chrono::milliseconds timeout) { acceptTimeout_ = timeout; }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_accept(IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
     private:
         HANDLE iocpHandle_ = INVALID_HANDLE_VALUE;
         SOCKET listenSocket_ = INVALID_SOCKET;
+        std::chrono::milliseconds acceptTimeout_{0};
     };
 
 } // namespace net
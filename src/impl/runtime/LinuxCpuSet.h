@@ -0,0 +1,28 @@
+#ifndef LINUX_CPU_SET_H
+#define LINUX_CPU_SET_H
+
+#include <sched.h>
+#include <vector>
+
+namespace net
+{
+    // 进程当前允许运行的 CPU，受 taskset / cgroup cpuset 限制
+    // Runtime 按这个顺序固定工作线程，分片的 UDP 套接字也按这个顺序对应 CPU
+    inline std::vector<int> allowed_cpus()
+    {
+        std::vector<int> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0)
+            return cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+} // namespace net
+
+#endif // LINUX_CPU_SET_H
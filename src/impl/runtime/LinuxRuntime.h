@@ -0,0 +1,213 @@
+#ifndef LINUX_RUNTIME_H
+#define LINUX_RUNTIME_H
+
+#include <liburing.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "Runtime.h"
+#include "LinuxIoContext.h"
+#include "LinuxCpuSet.h"
+
+namespace net
+{
+    // Runtime::Impl for Linux：每个工作线程使用自己线程的 io_uring，
+    // 通过各自的 eventfd 唤醒阻塞在 io_uring_submit_and_wait 中的线程
+    class Runtime::Impl
+    {
+    public:
+        using Callback = std::function<void(unsigned worker)>;
+
+        Impl() = default;
+
+        ~Impl()
+        {
+            stop();
+            join();
+        }
+
+        // 未指定时按进程可用的 CPU 数启动工作线程
+        unsigned worker_count(const RuntimeOptions &options) const
+        {
+            if (options.workers > 0)
+                return options.workers;
+            size_t cpus = allowed_cpus().size();
+            return cpus > 0 ? static_cast<unsigned>(cpus) : 1;
+        }
+
+        bool launch(const RuntimeOptions &options, Callback setup, Callback teardown, std::error_code &ec)
+        {
+            if (!workers_.empty())
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+
+            // 先在调用线程上确认内核支持这些创建参数，失败时不启动任何线程
+            if (!IoContext::Impl::probe(options.ring, ec))
+                return false;
+
+            unsigned count = worker_count(options);
+            std::vector<int> cpus;
+            if (options.pin_workers)
+                cpus = allowed_cpus();
+
+            // 先创建全部唤醒用的 eventfd，失败时不启动任何线程
+            for (unsigned i = 0; i < count; ++i)
+            {
+                std::unique_ptr<Worker> worker(new Worker());
+                worker->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                if (worker->wake_fd < 0)
+                {
+                    ec = std::error_code(errno, std::generic_category());
+                    workers_.clear();
+                    return false;
+                }
+                worker->cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+                workers_.push_back(std::move(worker));
+            }
+
+            stopping_.store(false, std::memory_order_release);
+            ring_ = options.ring;
+            setup_ = std::move(setup);
+            teardown_ = std::move(teardown);
+            started_ = 0;
+            start_error_.clear();
+            for (unsigned i = 0; i < count; ++i)
+                workers_[i]->thread = std::thread(&Impl::run_worker, this, i);
+
+            // 等待所有工作线程完成初始化；任何一个失败时全部线程不调用 setup 直接退出
+            std::error_code start_error;
+            {
+                std::unique_lock<std::mutex> lock(start_mutex_);
+                start_cv_.wait(lock, [this, count] { return started_ == count; });
+                start_error = start_error_;
+            }
+            if (start_error)
+            {
+                ec = start_error;
+                join();
+                return false;
+            }
+            return true;
+        }
+
+        void stop()
+        {
+            stopping_.store(true, std::memory_order_release);
+            for (auto &worker : workers_)
+            {
+                uint64_t value = 1;
+                ssize_t ret = write(worker->wake_fd, &value, sizeof(value));
+                (void)ret;
+            }
+        }
+
+        void join()
+        {
+            for (auto &worker : workers_)
+            {
+                if (worker->thread.joinable())
+                    worker->thread.join();
+            }
+            workers_.clear();
+            setup_ = nullptr;
+            teardown_ = nullptr;
+        }
+
+        unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    private:
+        struct Worker
+        {
+            ~Worker()
+            {
+                if (wake_fd >= 0)
+                    close(wake_fd);
+            }
+
+            std::thread thread;
+            int wake_fd = -1;
+            int cpu = -1;
+            IoOperation wake; // 只用于唤醒事件循环，完成时不做任何事
+        };
+
+        // 工作线程：固定 CPU，创建 io_uring 并挂上唤醒请求，
+        // 所有线程都初始化成功后才调用 setup 并驱动本线程的事件循环
+        void run_worker(unsigned index)
+        {
+            Worker &worker = *workers_[index];
+            std::error_code ec;
+            if (worker.cpu >= 0)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(worker.cpu, &set);
+                int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+                if (ret != 0)
+                    ec = std::error_code(ret, std::generic_category());
+            }
+
+            IoContext::Impl &context = *IoContext::current().impl_;
+            if (!ec && context.configure(ring_, ec) && context.init(ec))
+            {
+                io_uring_sqe *sqe = context.get_sqe(ec);
+                if (sqe)
+                {
+                    io_uring_prep_poll_add(sqe, worker.wake_fd, POLLIN);
+                    context.prepare(sqe, &worker.wake);
+                }
+            }
+
+            if (!report_started(ec))
+                return;
+
+            if (setup_)
+                setup_(index);
+
+            while (!ec && !stopping_.load(std::memory_order_acquire))
+                context.run_once(ec);
+
+            if (teardown_)
+                teardown_(index);
+        }
+
+        // 报告本线程的初始化结果并等待其他线程，所有线程都成功时返回 true
+        bool report_started(const std::error_code &ec)
+        {
+            std::unique_lock<std::mutex> lock(start_mutex_);
+            if (ec && !start_error_)
+                start_error_ = ec;
+            ++started_;
+            start_cv_.notify_all();
+
+            unsigned count = static_cast<unsigned>(workers_.size());
+            start_cv_.wait(lock, [this, count] { return started_ == count; });
+            return !start_error_;
+        }
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::mutex start_mutex_;
+        std::condition_variable start_cv_;
+        unsigned started_ = 0;       // 已完成初始化的工作线程数
+        std::error_code start_error_; // 第一个失败的工作线程的错误
+        std::atomic<bool> stopping_{false};
+        RingConfig ring_;
+        Callback setup_;
+        Callback teardown_;
+    };
+
+} // namespace net
+
+#endif // LINUX_RUNTIME_H
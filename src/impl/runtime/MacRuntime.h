@@ -0,0 +1,101 @@
+#ifndef MAC_RUNTIME_H
+#define MAC_RUNTIME_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "Runtime.h"
+
+namespace net
+{
+    // Runtime::Impl for macOS：该平台不能把线程固定到指定 CPU，
+    // 套接字也使用阻塞调用，工作线程在 setup 返回后等待 stop()
+    class Runtime::Impl
+    {
+    public:
+        using Callback = std::function<void(unsigned worker)>;
+
+        Impl() = default;
+
+        ~Impl()
+        {
+            stop();
+            join();
+        }
+
+        unsigned worker_count(const RuntimeOptions &options) const
+        {
+            if (options.workers > 0)
+                return options.workers;
+            unsigned cpus = std::thread::hardware_concurrency();
+            return cpus > 0 ? cpus : 1;
+        }
+
+        bool launch(const RuntimeOptions &options, Callback setup, Callback teardown, std::error_code &ec)
+        {
+            if (!threads_.empty())
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+
+            stopping_ = false;
+            setup_ = std::move(setup);
+            teardown_ = std::move(teardown);
+            unsigned count = worker_count(options);
+            for (unsigned i = 0; i < count; ++i)
+                threads_.emplace_back(&Impl::run_worker, this, i);
+            return true;
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            stopped_.notify_all();
+        }
+
+        void join()
+        {
+            for (auto &thread : threads_)
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+            threads_.clear();
+            setup_ = nullptr;
+            teardown_ = nullptr;
+        }
+
+        unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+    private:
+        void run_worker(unsigned index)
+        {
+            if (setup_)
+                setup_(index);
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                stopped_.wait(lock, [this] { return stopping_; });
+            }
+
+            if (teardown_)
+                teardown_(index);
+        }
+
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable stopped_;
+        bool stopping_ = false;
+        Callback setup_;
+        Callback teardown_;
+    };
+
+} // namespace net
+
+#endif // MAC_RUNTIME_H
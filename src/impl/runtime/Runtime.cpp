@@ -0,0 +1,117 @@
+#include "Runtime.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#if defined(_WIN32)
+#include "WindowsRuntime.h"
+#elif defined(__linux__)
+#include "LinuxRuntime.h"
+#elif defined(__APPLE__)
+#include "MacRuntime.h"
+#else
+#error "Unsupported platform"
+#endif
+
+namespace net
+{
+    // Runtime 类的构造和析构
+    Runtime::Runtime() : impl_(new Impl()) {}
+
+    Runtime::~Runtime()
+    {
+        delete impl_;
+    }
+
+    // 移动构造和移动赋值
+    Runtime::Runtime(Runtime&& other) noexcept : impl_(other.impl_)
+    {
+        other.impl_ = nullptr;
+    }
+
+    Runtime& Runtime::operator=(Runtime&& other) noexcept
+    {
+        if (this != &other)
+        {
+            delete impl_;
+            impl_ = other.impl_;
+            other.impl_ = nullptr;
+        }
+        return *this;
+    }
+
+    // 启动工作线程
+    bool Runtime::start(const RuntimeOptions& options, std::function<void(unsigned worker)> worker, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->launch(options, std::move(worker), nullptr, ec);
+    }
+
+    // 每个工作线程一个 SO_REUSEPORT 监听者
+    bool Runtime::serve(const std::string& address, int port, const RuntimeOptions& options,
+                        std::function<void(TcpListener& listener, unsigned worker)> worker, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+
+        // 先在调用线程上绑定全部监听者，任何一个失败都不启动工作线程
+        ListenOptions listen_options;
+        listen_options.reuse_port = true;
+        unsigned count = impl_->worker_count(options);
+        auto listeners = std::make_shared<std::vector<std::optional<TcpListener>>>(count);
+        for (unsigned i = 0; i < count; ++i)
+        {
+            (*listeners)[i] = TcpListener::bind(address, port, listen_options, ec);
+            if (!(*listeners)[i])
+            {
+                return false;
+            }
+        }
+
+        // 工作线程数与监听者数量保持一致
+        RuntimeOptions worker_options = options;
+        worker_options.workers = count;
+
+        // 每个线程只访问自己的监听者，并在退出前在本线程上销毁它
+        auto setup = [listeners, worker = std::move(worker)](unsigned index)
+        {
+            worker(*(*listeners)[index], index);
+        };
+        auto teardown = [listeners](unsigned index)
+        {
+            (*listeners)[index].reset();
+        };
+        return impl_->launch(worker_options, std::move(setup), std::move(teardown), ec);
+    }
+
+    // 停止工作线程
+    void Runtime::stop()
+    {
+        if (impl_)
+        {
+            impl_->stop();
+        }
+    }
+
+    // 等待工作线程退出
+    void Runtime::join()
+    {
+        if (impl_)
+        {
+            impl_->join();
+        }
+    }
+
+    unsigned Runtime::size() const
+    {
+        return impl_ ? impl_->size() : 0;
+    }
+}
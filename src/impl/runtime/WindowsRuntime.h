@@ -0,0 +1,111 @@
+#ifndef WINDOWS_RUNTIME_H
+#define WINDOWS_RUNTIME_H
+
+#include <windows.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "Runtime.h"
+
+namespace net
+{
+    // Runtime::Impl for Windows：套接字使用阻塞调用，工作线程在 setup 返回后等待 stop()
+    class Runtime::Impl
+    {
+    public:
+        using Callback = std::function<void(unsigned worker)>;
+
+        Impl() = default;
+
+        ~Impl()
+        {
+            stop();
+            join();
+        }
+
+        unsigned worker_count(const RuntimeOptions& options) const
+        {
+            if (options.workers > 0)
+                return options.workers;
+            unsigned cpus = std::thread::hardware_concurrency();
+            return cpus > 0 ? cpus : 1;
+        }
+
+        bool launch(const RuntimeOptions& options, Callback setup, Callback teardown, std::error_code& ec)
+        {
+            if (!threads_.empty())
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+
+            stopping_ = false;
+            pin_workers_ = options.pin_workers;
+            setup_ = std::move(setup);
+            teardown_ = std::move(teardown);
+            unsigned count = worker_count(options);
+            for (unsigned i = 0; i < count; ++i)
+                threads_.emplace_back(&Impl::run_worker, this, i);
+            return true;
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            stopped_.notify_all();
+        }
+
+        void join()
+        {
+            for (auto& thread : threads_)
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+            threads_.clear();
+            setup_ = nullptr;
+            teardown_ = nullptr;
+        }
+
+        unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+    private:
+        void run_worker(unsigned index)
+        {
+            // 亲和性掩码只覆盖当前处理器组的前 64 个逻辑处理器
+            unsigned cpus = std::thread::hardware_concurrency();
+            if (pin_workers_ && cpus > 0)
+            {
+                unsigned cpu = index % cpus;
+                if (cpu < 64)
+                    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+            }
+
+            if (setup_)
+                setup_(index);
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                stopped_.wait(lock, [this] { return stopping_; });
+            }
+
+            if (teardown_)
+                teardown_(index);
+        }
+
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable stopped_;
+        bool stopping_ = false;
+        bool pin_workers_ = true;
+        Callback setup_;
+        Callback teardown_;
+    };
+
+} // namespace net
+
+#endif // WINDOWS_RUNTIME_H
@@ -4,12 +4,22 @@
 #include <liburing.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
+#include <linux/filter.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
 #include <stdexcept>
+#include <cassert>
 #include <system_error>
+#include <vector>
+#include <deque>
+#include <memory>
 #include "UdpSocket.h"
+#include "LinuxIoContext.h"
+#include "LinuxBufferPool.h"
+#include "LinuxBufferRing.h"
+#include "LinuxCpuSet.h"
 
 namespace net
 {
@@ -17,55 +27,56 @@ namespace net
     class UdpSocket::Impl
     {
     public:
-        Impl() : socket_fd_(-1), ring_(nullptr) {}
+        Impl() : socket_fd_(-1) {}
 
-        Impl(int socket_fd, io_uring *ring) : socket_fd_(socket_fd), ring_(ring) {}
+        Impl(int socket_fd) : socket_fd_(socket_fd) {}
 
+        // 有进行中的接收或注册了固定文件的套接字必须在所属线程上销毁
         ~Impl()
         {
+            assert(!recv_ || !recv_->armed || recv_->context->impl_->is_current());
+            assert(!async_recv_ || !async_recv_->busy || async_recv_->context->is_current());
+            assert(!fixed_context_ || fixed_context_->is_current());
+            cancel_multishot();
+            cancel_async_recv();
+            if (fixed_context_)
+                fixed_context_->release_file_slot(fixed_index_);
             if (socket_fd_ >= 0)
                 close(socket_fd_);
-            if (ring_)
-            {
-                io_uring_queue_exit(ring_);
-                delete ring_;
-            }
         }
 
-        bool bind(const std::string &address, int port, std::error_code &ec)
+        bool bind(const std::string &address, int port, const UdpBindOptions &options, std::error_code &ec)
         {
-            // 创建 io_uring 实例
-            ring_ = new io_uring();
-            if (io_uring_queue_init(32, ring_, 0) < 0)
+            // 先解析地址，套接字的地址族跟随绑定地址，IPv6 地址得到 AF_INET6 套接字
+            std::optional<SocketAddr> local = SocketAddr::parse(address, port);
+            if (!local)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                delete ring_;
-                ring_ = nullptr;
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
+            sockaddr_storage local_addr = {};
+            socklen_t addr_len = local->to_sockaddr(local_addr);
 
             // 创建 socket
-            socket_fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+            socket_fd_ = ::socket(local_addr.ss_family, SOCK_DGRAM | SOCK_NONBLOCK, 0);
             if (socket_fd_ < 0)
             {
-                ec = std::make_error_code(std::errc::address_family_not_supported);
+                ec = std::error_code(errno, std::generic_category());
                 release();
                 return false;
             }
 
-            sockaddr_in local_addr = {};
-            local_addr.sin_family = AF_INET;
-            local_addr.sin_port = htons(port);
-            if (inet_pton(AF_INET, address.c_str(), &local_addr.sin_addr) <= 0)
+            int opt = 1;
+            if (options.reuse_port && setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0)
             {
-                ec = std::make_error_code(std::errc::invalid_argument);
+                ec = std::error_code(errno, std::generic_category());
                 release();
                 return false;
             }
 
-            if (::bind(socket_fd_, reinterpret_cast<sockaddr *>(&local_addr), sizeof(local_addr)) < 0)
+            if (::bind(socket_fd_, reinterpret_cast<sockaddr *>(&local_addr), addr_len) < 0)
             {
-                ec = std::make_error_code(std::errc::address_in_use);
+                ec = std::error_code(errno, std::generic_category());
                 release();
                 return false;
             }
@@ -73,63 +84,282 @@ namespace net
             return true;
         }
 
-        size_t send_to(const std::vector<uint8_t> &data, const std::string &address, int port, std::error_code &ec)
+        // 分片绑定：按顺序绑定的套接字在 reuseport 组中的下标依次为 0..shards-1，
+        // 组上的 BPF 程序读取处理数据包的 CPU 并返回对应的下标
+        static bool bind_sharded(const std::string &address, int port, unsigned shards,
+                                 std::vector<UdpSocket> &sockets, std::error_code &ec)
         {
-            if (socket_fd_ < 0 || !ring_)
+            std::vector<int> cpus = allowed_cpus();
+            if (cpus.empty())
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+            if (shards == 0)
+                shards = static_cast<unsigned>(cpus.size());
+
+            // 先在局部数组中完成全部绑定，失败时已创建的套接字随之关闭，不留在调用者的数组中
+            std::vector<UdpSocket> group;
+            group.reserve(shards);
+            UdpBindOptions options;
+            options.reuse_port = true;
+            for (unsigned i = 0; i < shards; ++i)
+            {
+                UdpSocket socket;
+                if (!socket.impl_->bind(address, port, options, ec))
+                    return false;
+
+                // 记录套接字所属的 CPU，内核在没有 BPF 程序时也会优先选择它
+                int cpu = cpus[i % cpus.size()];
+                if (setsockopt(socket.impl_->socket_fd_, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu)) < 0)
+                {
+                    ec = std::error_code(errno, std::generic_category());
+                    return false;
+                }
+                group.push_back(std::move(socket));
+            }
+
+            std::vector<sock_filter> program = cpu_steering_program(cpus, shards);
+            sock_fprog fprog = {};
+            fprog.len = static_cast<unsigned short>(program.size());
+            fprog.filter = program.data();
+            if (setsockopt(group.front().impl_->socket_fd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) < 0)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+
+            for (UdpSocket &socket : group)
+                sockets.push_back(std::move(socket));
+            return true;
+        }
+
+        // 把套接字注册到当前线程 io_uring 的固定文件表
+        bool register_fixed(std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
+            if (fixed_context_)
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+                return false;
+            }
+
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int slot = context.register_file(socket_fd_, ec);
+            if (slot < 0)
+                return false;
+            fixed_index_ = slot;
+            fixed_context_ = &context;
+            return true;
+        }
+
+        size_t send_to(ConstBuffer data, const SocketAddr &destination, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
                 ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
-            sockaddr_in remote_addr = {};
-            remote_addr.sin_family = AF_INET;
-            remote_addr.sin_port = htons(port);
-            if (inet_pton(AF_INET, address.c_str(), &remote_addr.sin_addr) <= 0)
+            sockaddr_storage remote_addr = {};
+            socklen_t addr_len = destination.to_sockaddr(remote_addr);
+            if (addr_len == 0)
             {
                 ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+            io_uring_sqe *sqe = context.get_sqe(ec);
             if (!sqe)
+                return 0;
+
+            io_uring_prep_sendto(sqe, fd, data.data(), data.size(), 0,
+                                 reinterpret_cast<sockaddr *>(&remote_addr), addr_len);
+            apply_target(sqe, context);
+
+            SyncOperation op;
+            context.prepare(sqe, &op);
+            if (!context.wait(op, ec))
+                return 0;
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+
+            return static_cast<size_t>(op.result);
+        }
+
+        // 批量发送：为每条数据报准备一个 sendmsg 请求，全部放入提交队列后
+        // 由一次 io_uring_submit_and_wait 提交，再统一收取完成事件
+        size_t send_batch(OutgoingDatagram *datagrams, size_t count, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+
+            // 先清除上一次的结果，之后每条数据报都一定会写入本次的结果
+            for (size_t i = 0; i < count; ++i)
+            {
+                datagrams[i].bytes_sent = 0;
+                datagrams[i].error.clear();
+            }
+
+            // 每条数据报的地址和 msghdr 在请求完成前必须保持有效
+            std::vector<SendSlot> slots(count);
+            size_t remaining = 0;
+            for (size_t i = 0; i < count; ++i)
             {
-                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+                OutgoingDatagram &datagram = datagrams[i];
+                SendSlot &slot = slots[i];
+                socklen_t addr_len = datagram.destination.to_sockaddr(slot.addr);
+                if (addr_len == 0)
+                {
+                    datagram.error = std::make_error_code(std::errc::invalid_argument);
+                    continue;
+                }
+
+                slot.iov.iov_base = const_cast<uint8_t *>(datagram.data.data());
+                slot.iov.iov_len = datagram.data.size();
+                slot.msg.msg_name = &slot.addr;
+                slot.msg.msg_namelen = addr_len;
+                slot.msg.msg_iov = &slot.iov;
+                slot.msg.msg_iovlen = 1;
+
+                // 提交队列腾不出位置时，这条及之后的数据报都不发送，错误记录在各自的条目中
+                std::error_code sqe_ec;
+                io_uring_sqe *sqe = context.get_sqe(sqe_ec);
+                if (!sqe)
+                {
+                    for (size_t j = i; j < count; ++j)
+                    {
+                        if (!datagrams[j].error)
+                            datagrams[j].error = sqe_ec;
+                    }
+                    break;
+                }
+                io_uring_prep_sendmsg(sqe, fd, &slot.msg, 0);
+                apply_target(sqe, context);
+
+                slot.complete = &SendSlot::on_complete;
+                slot.remaining = &remaining;
+                context.prepare(sqe, &slot);
+                ++remaining;
+            }
+
+            // 等待所有已提交的请求完成，即使中途取 SQE 失败也不能提前返回；
+            // 事件循环出错时 slots 仍被内核引用，数据报发送很快结束，等它们全部完成后再报告错误
+            std::error_code wait_ec;
+            if (!context.wait_until([&remaining] { return remaining == 0; }, wait_ec))
+            {
+                context.settle([&remaining] { return remaining == 0; });
+                ec = wait_ec;
                 return 0;
             }
 
-            io_uring_prep_sendto(sqe, socket_fd_, data.data(), data.size(), 0,
-                                 reinterpret_cast<sockaddr *>(&remote_addr), sizeof(remote_addr));
-            io_uring_submit(ring_);
+            size_t sent = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                // 未提交的条目已在上面记录了错误
+                if (!slots[i].remaining)
+                    continue;
+                if (slots[i].result < 0)
+                {
+                    datagrams[i].error = std::error_code(-slots[i].result, std::generic_category());
+                    continue;
+                }
+                datagrams[i].bytes_sent = static_cast<size_t>(slots[i].result);
+                ++sent;
+            }
+            return sent;
+        }
 
-            io_uring_cqe *cqe;
-            if (io_uring_wait_cqe(ring_, &cqe) < 0)
+        // 从固定缓冲区发送数据报：recvmsg/sendto 没有固定缓冲区版本，
+        // 这里使用带目标地址的 IORING_OP_SEND_ZC 并引用注册过的缓冲区；
+        // 内核不支持带地址的 SEND_ZC 时退回普通 sendto，之后的调用不再尝试
+        size_t send_to_fixed(const FixedBuffer &buffer, size_t size, const SocketAddr &destination, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (!buffer || size > buffer.capacity())
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return 0;
+            }
+            if (!buffer.pool() || buffer.pool()->context()->impl_ != &context)
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
                 return 0;
             }
 
-            if (cqe->res < 0)
+            if (!send_zc_supported_)
+                return send_to(ConstBuffer(buffer.data(), size), destination, ec);
+
+            sockaddr_storage remote_addr = {};
+            socklen_t addr_len = destination.to_sockaddr(remote_addr);
+            if (addr_len == 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                io_uring_cqe_seen(ring_, cqe);
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            size_t bytes_sent = cqe->res;
-            io_uring_cqe_seen(ring_, cqe);
-            return bytes_sent;
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_send_zc_fixed(sqe, fd, buffer.data(), size, 0, 0, BufferPool::Impl::kBufferIndex);
+            io_uring_prep_send_set_addr(sqe, reinterpret_cast<sockaddr *>(&remote_addr), addr_len);
+            apply_target(sqe, context);
+
+            // 等待发送结果和缓冲区释放通知
+            SyncOperation op;
+            context.prepare(sqe, &op);
+            if (!context.wait(op, ec))
+                return 0;
+
+            // 内核或套接字不支持零拷贝时从切片的地址普通发送
+            if (op.result == -EINVAL || op.result == -EOPNOTSUPP)
+            {
+                send_zc_supported_ = false;
+                return send_to(ConstBuffer(buffer.data(), size), destination, ec);
+            }
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
         }
 
-        size_t recv_from(std::vector<uint8_t> &buffer, std::string &address, int &port, std::error_code &ec)
+        // 接收数据报，启用 GRO 时同时返回合并前每个分段的大小，未合并时为 0
+        size_t recv_from(MutableBuffer buffer, SocketAddr &source, size_t &segment_size, std::error_code &ec)
         {
-            if (socket_fd_ < 0 || !ring_)
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
                 ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
             // 准备 sender 地址存储
-            sockaddr_in sender_addr = {};
+            sockaddr_storage sender_addr = {};
             socklen_t addr_len = sizeof(sender_addr);
 
             // 准备 msghdr 用于 recvmsg
@@ -143,46 +373,247 @@ namespace net
             msg.msg_iov = &iov;          // 数据缓冲区
             msg.msg_iovlen = 1;          // iovec 数量
 
-            // 从 io_uring 获取一个提交队列条目 (SQE)
-            io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+            // GRO 合并后的分段大小通过控制消息返回
+            alignas(cmsghdr) char control[kControlSize] = {};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            // 从当前线程的 io_uring 获取一个提交队列条目 (SQE)
+            io_uring_sqe *sqe = context.get_sqe(ec);
             if (!sqe)
+                return 0;
+
+            // 准备 recvmsg 操作
+            io_uring_prep_recvmsg(sqe, fd, &msg, 0);
+            apply_target(sqe, context);
+
+            // 提交并等待完成
+            SyncOperation op;
+            context.prepare(sqe, &op);
+            if (!context.wait(op, ec))
+                return 0;
+
+            if (op.result < 0)
             {
-                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+                ec = std::error_code(-op.result, std::generic_category());
                 return 0;
             }
 
-            // 准备 recvmsg 操作
-            io_uring_prep_recvmsg(sqe, socket_fd_, &msg, 0);
+            // 获取接收到的字节数
+            size_t bytes_received = op.result;
+
+            // 发送方地址保持二进制形式
+            source = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&sender_addr), msg.msg_namelen);
+
+            segment_size = 0;
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                segment_size = gro_segment_size(cmsg, segment_size);
+
+            return bytes_received;
+        }
+
+        // 启用 UDP_GRO：内核把同一流的连续数据报合并后一次交付
+        bool enable_gro(std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
 
-            // 提交队列
-            io_uring_submit(ring_);
+            int opt = 1;
+            if (setsockopt(socket_fd_, SOL_UDP, UDP_GRO, &opt, sizeof(opt)) < 0)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+            return true;
+        }
 
-            // 等待完成队列条目 (CQE)
-            io_uring_cqe *cqe;
-            if (io_uring_wait_cqe(ring_, &cqe) < 0)
+        // GSO 发送：一个大缓冲区作为一次 sendmsg 提交，由 UDP_SEGMENT 控制消息
+        // 指定分段大小，协议栈只遍历一次，在出口处切分为多个数据报
+        size_t send_to_segmented(ConstBuffer data, uint16_t segment_size, const SocketAddr &destination, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (segment_size == 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            if (cqe->res < 0)
+            sockaddr_storage remote_addr = {};
+            socklen_t addr_len = destination.to_sockaddr(remote_addr);
+            if (addr_len == 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                io_uring_cqe_seen(ring_, cqe);
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            // 获取接收到的字节数
-            size_t bytes_received = cqe->res;
-            io_uring_cqe_seen(ring_, cqe);
+            iovec iov = {};
+            iov.iov_base = const_cast<uint8_t *>(data.data());
+            iov.iov_len = data.size();
 
-            // 提取发送方地址和端口
-            char addr_str[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &sender_addr.sin_addr, addr_str, sizeof(addr_str));
-            address = addr_str;
-            port = ntohs(sender_addr.sin_port);
+            msghdr msg = {};
+            msg.msg_name = &remote_addr;
+            msg.msg_namelen = addr_len;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_sendmsg(sqe, fd, &msg, 0);
+            apply_target(sqe, context);
 
-            return bytes_received;
+            SyncOperation op;
+            context.prepare(sqe, &op);
+            if (!context.wait(op, ec))
+                return 0;
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
+        }
+
+        // 批量接收：首次调用时提交一个 multishot recvmsg，之后只需从队列中取数据报
+        size_t recv_batch(BufferRing &ring, std::vector<IncomingDatagram> &datagrams, std::error_code &ec)
+        {
+            IoContext &context = IoContext::current();
+            if (target(*context.impl_) < 0 || !ring.impl_)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (ring.impl_->context() != &context)
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
+                return 0;
+            }
+
+            // 接收状态只在使用 multishot 的套接字上分配
+            if (!recv_)
+                recv_.reset(new MultishotRecv());
+            MultishotRecv &state = *recv_;
+            if (state.armed && state.ring != ring.impl_)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return 0;
+            }
+
+            while (state.datagrams.empty())
+            {
+                if (state.error)
+                {
+                    ec = state.error;
+                    state.error.clear();
+                    return 0;
+                }
+                if (!state.armed && !arm_multishot(state, *ring.impl_, ec))
+                    return 0;
+                context.impl_->run_once(ec);
+                if (ec)
+                    return 0;
+            }
+
+            size_t count = 0;
+            while (!state.datagrams.empty())
+            {
+                datagrams.push_back(std::move(state.datagrams.front()));
+                state.datagrams.pop_front();
+                ++count;
+            }
+            return count;
+        }
+
+        // 异步接收：msghdr 和发送方地址保存在套接字内部直到完成，因此同一时间只能有一个
+        // 未完成的异步接收；完成时先填写 source，再把接收的字节数交给 op
+        bool start_recv_from(MutableBuffer buffer, SocketAddr &source, IoOperation *op, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
+
+            if (!async_recv_)
+                async_recv_.reset(new AsyncRecv());
+            AsyncRecv &state = *async_recv_;
+            if (state.busy)
+            {
+                ec = std::make_error_code(std::errc::operation_in_progress);
+                return false;
+            }
+
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+                return false;
+
+            state.iov.iov_base = buffer.data();
+            state.iov.iov_len = buffer.size();
+            state.msg = {};
+            state.msg.msg_name = &state.addr;
+            state.msg.msg_namelen = sizeof(state.addr);
+            state.msg.msg_iov = &state.iov;
+            state.msg.msg_iovlen = 1;
+            io_uring_prep_recvmsg(sqe, fd, &state.msg, 0);
+            apply_target(sqe, context);
+
+            state.complete = &Impl::on_async_recv;
+            state.source = &source;
+            state.handler = op;
+            state.context = &context;
+            state.busy = true;
+            context.prepare(sqe, &state);
+            return true;
+        }
+
+        // 异步发送：只准备请求，目标地址保存在调用者提供的 remote_addr 中，由调用者提交
+        bool start_send_to(ConstBuffer data, const SocketAddr &destination, sockaddr_storage &remote_addr,
+                           IoOperation *op, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
+
+            socklen_t addr_len = destination.to_sockaddr(remote_addr);
+            if (addr_len == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_sendto(sqe, fd, data.data(), data.size(), 0,
+                                 reinterpret_cast<sockaddr *>(&remote_addr), addr_len);
+            apply_target(sqe, context);
+            context.prepare(sqe, op);
+            return true;
         }
 
     private:
@@ -193,16 +624,189 @@ namespace net
                 close(socket_fd_);
                 socket_fd_ = -1;
             }
-            if (ring_)
+        }
+
+        // 按 CPU 选择套接字的经典 BPF 程序：前 shards 个可用 CPU 逐个比较后返回对应的下标，
+        // 其他 CPU（例如之后才加入 cpuset 的）按 CPU 号取模
+        static std::vector<sock_filter> cpu_steering_program(const std::vector<int> &cpus, unsigned shards)
+        {
+            size_t mapped = cpus.size() < shards ? cpus.size() : shards;
+            size_t max_mapped = (BPF_MAXINSNS - 3) / 2;
+            if (mapped > max_mapped)
+                mapped = max_mapped;
+
+            std::vector<sock_filter> program;
+            program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+            for (size_t i = 0; i < mapped; ++i)
+            {
+                program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpus[i]), 0, 1));
+                program.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(i)));
+            }
+            program.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, shards));
+            program.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+            return program;
+        }
+
+        // 接收时预留的控制消息空间，足够容纳 UDP_GRO 的分段大小
+        static constexpr size_t kControlSize = CMSG_SPACE(sizeof(int));
+
+        static size_t gro_segment_size(const cmsghdr *cmsg, size_t current)
+        {
+            if (cmsg->cmsg_level != SOL_UDP || cmsg->cmsg_type != UDP_GRO)
+                return current;
+
+            int segment_size = 0;
+            std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+            return static_cast<size_t>(segment_size);
+        }
+
+        struct MultishotRecv : IoOperation
+        {
+            BufferRing::Impl *ring = nullptr;
+            IoContext *context = nullptr;
+            msghdr msg = {};
+            std::deque<IncomingDatagram> datagrams;
+            std::error_code error;
+            bool armed = false;
+        };
+
+        // multishot recvmsg 的完成回调：每个缓冲区依次存放 io_uring_recvmsg_out 头、
+        // 源地址、控制消息和数据报内容
+        static void on_recv(IoOperation *op, int result, unsigned flags)
+        {
+            auto *state = static_cast<MultishotRecv *>(op);
+            ProvidedBuffer buffer = state->ring->take(result > 0 ? result : 0, flags);
+            if (result > 0)
+            {
+                void *data = const_cast<uint8_t *>(buffer.data());
+                io_uring_recvmsg_out *out = io_uring_recvmsg_validate(data, result, &state->msg);
+                if (out)
+                {
+                    IncomingDatagram datagram;
+                    auto *payload = static_cast<const uint8_t *>(io_uring_recvmsg_payload(out, &state->msg));
+                    datagram.payload = ConstBuffer(payload, io_uring_recvmsg_payload_length(out, result, &state->msg));
+
+                    // 发送方地址保持二进制形式，内核截断时只取缓冲区中实际存放的部分
+                    size_t name_len = out->namelen < state->msg.msg_namelen ? out->namelen : state->msg.msg_namelen;
+                    datagram.source = SocketAddr::from_sockaddr(
+                        static_cast<const sockaddr *>(io_uring_recvmsg_name(out)), name_len);
+
+                    // 启用 GRO 时的分段大小
+                    for (cmsghdr *cmsg = io_uring_recvmsg_cmsg_firsthdr(out, &state->msg); cmsg;
+                         cmsg = io_uring_recvmsg_cmsg_nexthdr(out, &state->msg, cmsg))
+                        datagram.segment_size = gro_segment_size(cmsg, datagram.segment_size);
+                    datagram.buffer = std::move(buffer);
+                    state->datagrams.push_back(std::move(datagram));
+                }
+            }
+            else if (result < 0 && result != -ECANCELED)
+                state->error = std::error_code(-result, std::generic_category());
+
+            // 缓冲区耗尽（ENOBUFS）时内核终止请求，归还缓冲区后可重新提交
+            if (!(flags & IORING_CQE_F_MORE))
+                state->armed = false;
+        }
+
+        bool arm_multishot(MultishotRecv &state, BufferRing::Impl &ring, std::error_code &ec)
+        {
+            IoContext &context = IoContext::current();
+            io_uring_sqe *sqe = context.impl_->get_sqe(ec);
+            if (!sqe)
+                return false;
+
+            // msghdr 只描述每个缓冲区中地址和控制消息区域的长度，请求存续期间必须保持有效
+            state.msg = {};
+            state.msg.msg_namelen = sizeof(sockaddr_in6);
+            state.msg.msg_controllen = kControlSize;
+            io_uring_prep_recvmsg_multishot(sqe, target(*context.impl_), &state.msg, 0);
+            apply_target(sqe, *context.impl_);
+            sqe->flags |= IOSQE_BUFFER_SELECT;
+            sqe->buf_group = ring.group_id();
+
+            state.complete = &Impl::on_recv;
+            state.ring = &ring;
+            state.context = &context;
+            state.armed = true;
+            context.impl_->prepare(sqe, &state);
+            return true;
+        }
+
+        // 取消仍在进行的 multishot recvmsg，并等待其最后一个完成事件
+        void cancel_multishot()
+        {
+            if (!recv_ || !recv_->armed)
+                return;
+
+            MultishotRecv &state = *recv_;
+            state.context->impl_->cancel(&state, [&state] { return !state.armed; });
+        }
+
+        // 异步接收的请求状态
+        struct AsyncRecv : IoOperation
+        {
+            sockaddr_storage addr = {};
+            iovec iov = {};
+            msghdr msg = {};
+            SocketAddr *source = nullptr;
+            IoOperation *handler = nullptr;
+            IoContext::Impl *context = nullptr;
+            bool busy = false;
+        };
+
+        static void on_async_recv(IoOperation *op, int result, unsigned flags)
+        {
+            auto *state = static_cast<AsyncRecv *>(op);
+            state->busy = false;
+            if (result >= 0)
+                *state->source = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&state->addr), state->msg.msg_namelen);
+            state->handler->complete(state->handler, result, flags);
+        }
+
+        // 取消仍在进行的异步接收，调用方的 op 会收到 ECANCELED
+        void cancel_async_recv()
+        {
+            if (!async_recv_ || !async_recv_->busy)
+                return;
+
+            AsyncRecv &state = *async_recv_;
+            state.context->cancel(&state, [&state] { return !state.busy; });
+        }
+
+        // 批量发送中单条数据报的请求状态
+        struct SendSlot : IoOperation
+        {
+            static void on_complete(IoOperation *op, int result, unsigned)
             {
-                io_uring_queue_exit(ring_);
-                delete ring_;
-                ring_ = nullptr;
+                auto *slot = static_cast<SendSlot *>(op);
+                slot->result = result;
+                --*slot->remaining;
             }
+
+            sockaddr_storage addr = {};
+            iovec iov = {};
+            msghdr msg = {};
+            int result = 0;
+            size_t *remaining = nullptr;
+        };
+
+        // 在注册所在线程的 io_uring 上使用固定文件索引，其他线程使用普通描述符
+        int target(const IoContext::Impl &context) const
+        {
+            return fixed_context_ == &context ? fixed_index_ : socket_fd_;
+        }
+
+        void apply_target(io_uring_sqe *sqe, const IoContext::Impl &context) const
+        {
+            if (fixed_context_ == &context)
+                sqe->flags |= IOSQE_FIXED_FILE;
         }
 
         int socket_fd_;
-        io_uring *ring_;
+        int fixed_index_ = -1;
+        IoContext::Impl *fixed_context_ = nullptr;
+        bool send_zc_supported_ = true; // send_to_fixed 的 SEND_ZC 被拒绝后改为普通发送
+        std::unique_ptr<MultishotRecv> recv_;
+        std::unique_ptr<AsyncRecv> async_recv_;
     };
 
 } // namespace net
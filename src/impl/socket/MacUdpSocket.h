@@ -24,35 +24,36 @@ namespace net
         }
 
         // 绑定到指定地址和端口
-        bool bind(const std::string &address, int port, std::error_code &ec)
+        bool bind(const std::string &address, int port, const UdpBindOptions &options, std::error_code &ec)
         {
-            socket_fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
-            if (socket_fd_ == -1)
+            // "*" 表示所有网络接口；套接字的地址族跟随绑定地址
+            std::optional<SocketAddr> local = SocketAddr::parse(address == "*" ? "0.0.0.0" : address, port);
+            if (!local)
             {
-                ec.assign(errno, std::system_category());
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return false;
             }
+            sockaddr_storage addr{};
+            socklen_t addr_len = static_cast<socklen_t>(local->to_sockaddr(addr));
 
-            sockaddr_in addr{};
-            addr.sin_family = AF_INET;
-            addr.sin_port = htons(port);
-
-            if (address == "0.0.0.0" || address == "*")
+            socket_fd_ = ::socket(addr.ss_family, SOCK_DGRAM, 0);
+            if (socket_fd_ == -1)
             {
-                addr.sin_addr.s_addr = INADDR_ANY; // 绑定所有网络接口
+                ec.assign(errno, std::system_category());
+                return false;
             }
-            else
+
+            // 该平台的 SO_REUSEPORT 只允许共享端口，不在套接字之间均衡分配数据报
+            int opt = 1;
+            if (options.reuse_port && setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) == -1)
             {
-                if (::inet_pton(AF_INET, address.c_str(), &addr.sin_addr) <= 0)
-                {
-                    ec.assign(errno, std::system_category());
-                    close(socket_fd_);
-                    socket_fd_ = -1;
-                    return false;
-                }
+                ec.assign(errno, std::system_category());
+                close(socket_fd_);
+                socket_fd_ = -1;
+                return false;
             }
 
-            if (::bind(socket_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == -1)
+            if (::bind(socket_fd_, reinterpret_cast<sockaddr *>(&addr), addr_len) == -1)
             {
                 ec.assign(errno, std::system_category());
                 close(socket_fd_);
@@ -63,21 +64,33 @@ namespace net
             return true;
         }
 
-        // 发送数据到指定目标
-        size_t send_to(const std::vector<uint8_t> &data, const std::string &address, int port, std::error_code &ec)
+        // 该平台没有按 CPU 分配数据报的 reuseport 组
+        static bool bind_sharded(const std::string &, int, unsigned, std::vector<UdpSocket> &, std::error_code &ec)
         {
-            sockaddr_in dest_addr{};
-            dest_addr.sin_family = AF_INET;
-            dest_addr.sin_port = htons(port);
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        // 该平台没有固定文件表
+        bool register_fixed(std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
 
-            if (::inet_pton(AF_INET, address.c_str(), &dest_addr.sin_addr) <= 0)
+        // 发送数据到指定目标
+        size_t send_to(ConstBuffer data, const SocketAddr &destination, std::error_code &ec)
+        {
+            sockaddr_storage dest_addr{};
+            socklen_t addr_len = destination.to_sockaddr(dest_addr);
+            if (addr_len == 0)
             {
-                ec.assign(errno, std::system_category());
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
             ssize_t bytes_sent = ::sendto(socket_fd_, data.data(), data.size(), 0,
-                                          reinterpret_cast<sockaddr *>(&dest_addr), sizeof(dest_addr));
+                                          reinterpret_cast<sockaddr *>(&dest_addr), addr_len);
             if (bytes_sent == -1)
             {
                 ec.assign(errno, std::system_category());
@@ -87,10 +100,17 @@ namespace net
             return static_cast<size_t>(bytes_sent);
         }
 
-        // 从远程地址接收数据
-        size_t recv_from(std::vector<uint8_t> &buffer, std::string &address, int &port, std::error_code &ec)
+        // 该平台没有固定缓冲区
+        size_t send_to_fixed(const FixedBuffer &, size_t, const SocketAddr &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 从远程地址接收数据，该平台没有 GRO，数据报总是单独交付
+        size_t recv_from(MutableBuffer buffer, SocketAddr &source, size_t &segment_size, std::error_code &ec)
         {
-            sockaddr_in src_addr{};
+            sockaddr_storage src_addr{};
             socklen_t addr_len = sizeof(src_addr);
 
             ssize_t bytes_received = ::recvfrom(socket_fd_, buffer.data(), buffer.size(), 0,
@@ -101,15 +121,72 @@ namespace net
                 return 0;
             }
 
-            // 将接收到的源地址转换为字符串
-            char ip_str[INET_ADDRSTRLEN];
-            if (::inet_ntop(AF_INET, &src_addr.sin_addr, ip_str, sizeof(ip_str)) != nullptr)
+            source = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr *>(&src_addr), addr_len);
+            segment_size = 0;
+            return static_cast<size_t>(bytes_received);
+        }
+
+        // 该平台没有批量提交，逐条发送
+        size_t send_batch(OutgoingDatagram *datagrams, size_t count, std::error_code &)
+        {
+            size_t sent = 0;
+            for (size_t i = 0; i < count; ++i)
             {
-                address = ip_str;
-                port = ntohs(src_addr.sin_port);
+                OutgoingDatagram &datagram = datagrams[i];
+                datagram.error.clear();
+                datagram.bytes_sent = send_to(datagram.data, datagram.destination, datagram.error);
+                if (!datagram.error)
+                    ++sent;
             }
+            return sent;
+        }
 
-            return static_cast<size_t>(bytes_received);
+        // 该平台没有内核提供的缓冲区环
+        size_t recv_batch(BufferRing &, std::vector<IncomingDatagram> &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        bool enable_gro(std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        // 该平台没有 GSO，逐段发送
+        size_t send_to_segmented(ConstBuffer data, uint16_t segment_size, const SocketAddr &destination, std::error_code &ec)
+        {
+            if (segment_size == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return 0;
+            }
+
+            size_t total = 0;
+            while (total < data.size())
+            {
+                ConstBuffer rest = data.advance(total);
+                size_t length = rest.size() < segment_size ? rest.size() : segment_size;
+                size_t bytes_sent = send_to(ConstBuffer(rest.data(), length), destination, ec);
+                if (ec || bytes_sent == 0)
+                    break;
+                total += bytes_sent;
+            }
+            return total;
+        }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_recv_from(MutableBuffer, SocketAddr &, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_send_to(ConstBuffer, const SocketAddr &, sockaddr_storage &, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
         }
 
     private:
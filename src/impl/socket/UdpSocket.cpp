@@ -40,34 +40,211 @@ namespace net
 
     // 绑定到本地地址和端口
     std::optional<UdpSocket> UdpSocket::bind(const std::string& address, int port, std::error_code& ec)
+    {
+        return bind(address, port, UdpBindOptions(), ec);
+    }
+
+    std::optional<UdpSocket> UdpSocket::bind(const std::string& address, int port, const UdpBindOptions& options, std::error_code& ec)
     {
         UdpSocket socket;
-        if (socket.impl_->bind(address, port, ec))
+        if (socket.impl_->bind(address, port, options, ec))
         {
             return socket;
         }
         return std::nullopt;
     }
 
+    // 按 CPU 分片绑定
+    std::vector<UdpSocket> UdpSocket::bind_sharded(const std::string& address, int port, unsigned shards, std::error_code& ec)
+    {
+        // 失败时不会留下部分绑定的套接字
+        std::vector<UdpSocket> sockets;
+        Impl::bind_sharded(address, port, shards, sockets, ec);
+        return sockets;
+    }
+
+    // 注册为固定文件
+    bool UdpSocket::register_fixed(std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->register_fixed(ec);
+    }
+
+    // 解析文本地址，失败时设置 invalid_argument
+    static std::optional<SocketAddr> resolve(const std::string& address, int port, std::error_code& ec)
+    {
+        auto addr = SocketAddr::parse(address, port);
+        if (!addr)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+        }
+        return addr;
+    }
+
     // 发送数据到目标地址
     size_t UdpSocket::send_to(const std::vector<uint8_t>& data, const std::string& address, int port, std::error_code& ec)
+    {
+        return send_to(ConstBuffer(data), address, port, ec);
+    }
+
+    size_t UdpSocket::send_to(ConstBuffer data, const std::string& address, int port, std::error_code& ec)
+    {
+        auto destination = resolve(address, port, ec);
+        if (!destination)
+        {
+            return 0;
+        }
+        return send_to(data, *destination, ec);
+    }
+
+    size_t UdpSocket::send_to(ConstBuffer data, const SocketAddr& destination, std::error_code& ec)
     {
         if (!impl_)
         {
             ec = std::make_error_code(std::errc::bad_file_descriptor);
             return 0;
         }
-        return impl_->send_to(data, address, port, ec);
+        return impl_->send_to(data, destination, ec);
+    }
+
+    // 批量发送数据报
+    size_t UdpSocket::send_batch(OutgoingDatagram* datagrams, size_t count, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->send_batch(datagrams, count, ec);
+    }
+
+    // 从固定缓冲区发送数据到目标地址
+    size_t UdpSocket::send_to_fixed(const FixedBuffer& buffer, size_t size, const std::string& address, int port, std::error_code& ec)
+    {
+        auto destination = resolve(address, port, ec);
+        if (!destination)
+        {
+            return 0;
+        }
+        return send_to_fixed(buffer, size, *destination, ec);
+    }
+
+    size_t UdpSocket::send_to_fixed(const FixedBuffer& buffer, size_t size, const SocketAddr& destination, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->send_to_fixed(buffer, size, destination, ec);
     }
 
     // 从远程地址接收数据
     size_t UdpSocket::recv_from(std::vector<uint8_t>& buffer, std::string& address, int& port, std::error_code& ec)
+    {
+        return recv_from(MutableBuffer(buffer), address, port, ec);
+    }
+
+    size_t UdpSocket::recv_from(MutableBuffer buffer, std::string& address, int& port, std::error_code& ec)
+    {
+        size_t segment_size = 0;
+        return recv_from(buffer, address, port, segment_size, ec);
+    }
+
+    size_t UdpSocket::recv_from(MutableBuffer buffer, std::string& address, int& port, size_t& segment_size, std::error_code& ec)
+    {
+        SocketAddr source;
+        size_t bytes_received = recv_from(buffer, source, segment_size, ec);
+        if (!ec)
+        {
+            address = source.address();
+            port = source.port();
+        }
+        return bytes_received;
+    }
+
+    size_t UdpSocket::recv_from(MutableBuffer buffer, SocketAddr& source, std::error_code& ec)
+    {
+        size_t segment_size = 0;
+        return recv_from(buffer, source, segment_size, ec);
+    }
+
+    size_t UdpSocket::recv_from(MutableBuffer buffer, SocketAddr& source, size_t& segment_size, std::error_code& ec)
     {
         if (!impl_)
         {
             ec = std::make_error_code(std::errc::bad_file_descriptor);
             return 0;
         }
-        return impl_->recv_from(buffer, address, port, ec);
+        return impl_->recv_from(buffer, source, segment_size, ec);
+    }
+
+    // 启用 GRO
+    bool UdpSocket::enable_gro(std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->enable_gro(ec);
+    }
+
+    // 分段发送
+    size_t UdpSocket::send_to_segmented(ConstBuffer data, uint16_t segment_size, const std::string& address, int port, std::error_code& ec)
+    {
+        auto destination = resolve(address, port, ec);
+        if (!destination)
+        {
+            return 0;
+        }
+        return send_to_segmented(data, segment_size, *destination, ec);
+    }
+
+    size_t UdpSocket::send_to_segmented(ConstBuffer data, uint16_t segment_size, const SocketAddr& destination, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->send_to_segmented(data, segment_size, destination, ec);
+    }
+
+    // 批量接收数据报
+    size_t UdpSocket::recv_batch(BufferRing& ring, std::vector<IncomingDatagram>& datagrams, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->recv_batch(ring, datagrams, ec);
+    }
+
+    // 提交异步接收
+    bool UdpSocket::start_recv_from(MutableBuffer buffer, SocketAddr& source, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_recv_from(buffer, source, op, ec);
+    }
+
+    // 准备异步发送，由调用者提交
+    bool UdpSocket::start_send_to(ConstBuffer data, const SocketAddr& destination, sockaddr_storage& storage, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_send_to(data, destination, storage, op, ec);
     }
-}
+}
\ No newline at end of file
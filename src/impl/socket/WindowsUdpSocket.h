@@ -11,6 +11,7 @@
 #include <system_error>
 #include <memory>
 #include <mutex>
+#include <cstring>
 #include "UdpSocket.h"
 
 #pragma comment(lib, "ws2_32.lib")
@@ -41,8 +42,28 @@ namespace net
             stop();
         }
 
-        bool bind(const std::string& address, int port, std::error_code& ec)
+        bool bind(const std::string& address, int port, const UdpBindOptions& options, std::error_code& ec)
         {
+            // 该平台没有 SO_REUSEPORT
+            if (options.reuse_port)
+            {
+                ec = std::make_error_code(std::errc::operation_not_supported);
+                return false;
+            }
+
+            // 该平台的接收路径只处理 IPv4 地址，IPv6 地址直接拒绝
+            std::optional<SocketAddr> local = SocketAddr::parse(address, port);
+            if (!local)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            if (local->family() != SocketAddr::Family::V4)
+            {
+                ec = std::make_error_code(std::errc::address_family_not_supported);
+                return false;
+            }
+
             std::lock_guard<std::mutex> lock(mutex_);
             if (socket_ != INVALID_SOCKET)
             {
@@ -57,16 +78,9 @@ namespace net
                 return false;
             }
 
-            sockaddr_in local_addr = {};
-            local_addr.sin_family = AF_INET;
-            local_addr.sin_port = htons(port);
-            if (inet_pton(AF_INET, address.c_str(), &local_addr.sin_addr) <= 0)
-            {
-                ec = std::make_error_code(std::errc::invalid_argument);
-                return false;
-            }
-
-            if (::bind(socket_, reinterpret_cast<sockaddr*>(&local_addr), sizeof(local_addr)) == SOCKET_ERROR)
+            sockaddr_storage local_addr = {};
+            int addr_len = static_cast<int>(local->to_sockaddr(local_addr));
+            if (::bind(socket_, reinterpret_cast<sockaddr*>(&local_addr), addr_len) == SOCKET_ERROR)
             {
                 ec = std::make_error_code(static_cast<std::errc>(WSAGetLastError()));
                 return false;
@@ -83,27 +97,40 @@ namespace net
             return true;
         }
 
-        size_t send_to(const std::vector<uint8_t>& data, const std::string& address, int port, std::error_code& ec)
+        // 该平台没有按 CPU 分配数据报的 reuseport 组
+        static bool bind_sharded(const std::string&, int, unsigned, std::vector<UdpSocket>&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        // 该平台没有固定文件表
+        bool register_fixed(std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        size_t send_to(ConstBuffer data, const SocketAddr& destination, std::error_code& ec)
         {
             ensure_initialized(ec);
             if (ec)
                 return 0;
 
-            sockaddr_in remote_addr = {};
-            remote_addr.sin_family = AF_INET;
-            remote_addr.sin_port = htons(port);
-            if (inet_pton(AF_INET, address.c_str(), &remote_addr.sin_addr) <= 0)
+            sockaddr_storage remote_addr = {};
+            int addr_len = static_cast<int>(destination.to_sockaddr(remote_addr));
+            if (addr_len == 0)
             {
                 ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            auto* key = new IOCPKey{ IOCPKey::Type::Send, {}, data, {}, 0 };
+            auto* key = new IOCPKey{ IOCPKey::Type::Send, {}, std::vector<uint8_t>(data.data(), data.data() + data.size()), {}, 0 };
 
             WSABUF wsabuf = { static_cast<ULONG>(data.size()), reinterpret_cast<char*>(key->buffer.data()) };
             DWORD bytes_sent = 0;
             int result = WSASendTo(socket_, &wsabuf, 1, &bytes_sent, 0,
-                reinterpret_cast<sockaddr*>(&remote_addr), sizeof(remote_addr),
+                reinterpret_cast<sockaddr*>(&remote_addr), addr_len,
                 &key->overlapped, nullptr);
 
             if (result == SOCKET_ERROR && WSAGetLastError() != WSA_IO_PENDING)
@@ -116,7 +143,15 @@ namespace net
             return bytes_sent;
         }
 
-        size_t recv_from(std::vector<uint8_t>& buffer, std::string& address, int& port, std::error_code& ec)
+        // 该平台没有固定缓冲区
+        size_t send_to_fixed(const FixedBuffer&, size_t, const SocketAddr&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 该平台没有 GRO，数据报总是单独交付
+        size_t recv_from(MutableBuffer buffer, SocketAddr& source, size_t& segment_size, std::error_code& ec)
         {
             ensure_initialized(ec);
             if (ec)
@@ -147,24 +182,84 @@ namespace net
                 return 0;
             }
 
-            buffer = std::move(key->buffer);
+            std::memcpy(buffer.data(), key->buffer.data(), bytes_transferred);
 
-            sockaddr_in* remote_addr = reinterpret_cast<sockaddr_in*>(&key->remote_addr);
-            char addr_buffer[INET_ADDRSTRLEN] = {};
-            if (inet_ntop(AF_INET, &remote_addr->sin_addr, addr_buffer, sizeof(addr_buffer)) == nullptr)
+            source = SocketAddr::from_sockaddr(reinterpret_cast<sockaddr*>(&key->remote_addr), key->remote_addr_len);
+            if (source.empty())
             {
                 delete key;
                 ec = std::make_error_code(std::errc::address_not_available);
                 return 0;
             }
-
-            address = addr_buffer;
-            port = ntohs(remote_addr->sin_port);
+            segment_size = 0;
 
             delete key;
             return bytes_transferred;
         }
 
+        // 该平台没有批量提交，逐条发送
+        size_t send_batch(OutgoingDatagram* datagrams, size_t count, std::error_code&)
+        {
+            size_t sent = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                OutgoingDatagram &datagram = datagrams[i];
+                datagram.error.clear();
+                datagram.bytes_sent = send_to(datagram.data, datagram.destination, datagram.error);
+                if (!datagram.error)
+                    ++sent;
+            }
+            return sent;
+        }
+
+        // 该平台没有内核提供的缓冲区环
+        size_t recv_batch(BufferRing&, std::vector<IncomingDatagram>&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        bool enable_gro(std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        // 该平台没有 GSO，逐段发送
+        size_t send_to_segmented(ConstBuffer data, uint16_t segment_size, const SocketAddr& destination, std::error_code& ec)
+        {
+            if (segment_size == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return 0;
+            }
+
+            size_t total = 0;
+            while (total < data.size())
+            {
+                ConstBuffer rest = data.advance(total);
+                size_t length = rest.size() < segment_size ? rest.size() : segment_size;
+                size_t bytes_sent = send_to(ConstBuffer(rest.data(), length), destination, ec);
+                if (ec || bytes_sent == 0)
+                    break;
+                total += bytes_sent;
+            }
+            return total;
+        }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_recv_from(MutableBuffer, SocketAddr&, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_send_to(ConstBuffer, const SocketAddr&, sockaddr_storage&, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
     private:
         SOCKET socket_ = INVALID_SOCKET;
         HANDLE iocp_ = nullptr;
@@ -3,51 +3,136 @@
 
 #include <liburing.h>
 #include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
+#include <chrono>
 #include <stdexcept>
+#include <cassert>
 #include <system_error>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "LinuxIoContext.h"
+#include "LinuxBufferRing.h"
+#include "LinuxBufferPool.h"
 
 namespace net
 {
+    // splice 转发使用的管道，数据以页面引用的形式经过，容量决定每次转发的块大小
+    class SplicePipe
+    {
+    public:
+        // 扩大失败时沿用系统默认的 64 KiB
+        static constexpr int kCapacity = 1024 * 1024;
+
+        SplicePipe() = default;
+        ~SplicePipe() { close(); }
+
+        SplicePipe(const SplicePipe &) = delete;
+        SplicePipe &operator=(const SplicePipe &) = delete;
+
+        // 已经打开时直接返回
+        bool open(std::error_code &ec)
+        {
+            if (fds_[0] >= 0)
+                return true;
+            if (pipe2(fds_, O_CLOEXEC) < 0)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+            fcntl(fds_[1], F_SETPIPE_SZ, kCapacity);
+            int size = fcntl(fds_[1], F_GETPIPE_SZ);
+            size_ = size > 0 ? static_cast<size_t>(size) : 64 * 1024;
+            return true;
+        }
+
+        // 丢弃管道和其中残留的数据
+        void close()
+        {
+            if (fds_[0] < 0)
+                return;
+            ::close(fds_[0]);
+            ::close(fds_[1]);
+            fds_[0] = -1;
+            fds_[1] = -1;
+        }
+
+        int read_fd() const { return fds_[0]; }
+        int write_fd() const { return fds_[1]; }
+        size_t size() const { return size_; }
+
+    private:
+        int fds_[2] = {-1, -1};
+        size_t size_ = 0;
+    };
+
     // TcpStream::Impl for Linux with io_uring
+    // 所有操作提交到调用线程的 IoContext，连接本身只保存文件描述符
     class TcpStream::Impl
     {
     public:
-		Impl() : socket_fd_(-1), ring_(nullptr) {}
-        Impl(int socket_fd, io_uring *ring) : socket_fd_(socket_fd), ring_(ring) {}
+        Impl() : socket_fd_(-1) {}
+        Impl(int socket_fd) : socket_fd_(socket_fd) {}
 
+        // 启用了 multishot 读取或注册了固定文件的连接必须在所属线程上销毁
         ~Impl()
         {
+            assert(!recv_ || !recv_->armed || recv_->context->impl_->is_current());
+            assert(!fixed_context_ || fixed_context_->is_current());
+            cancel_multishot();
+            if (fixed_context_)
+                fixed_context_->release_file_slot(fixed_index_);
             if (socket_fd_ >= 0)
                 close(socket_fd_);
-            if (ring_)
-            {
-                io_uring_queue_exit(ring_);
-                delete ring_;
-            }
         }
 
-        bool connect(const std::string &address, int port, std::error_code &ec)
+        // 把连接注册到当前线程 io_uring 的固定文件表，之后在该线程上的请求
+        // 使用 IOSQE_FIXED_FILE，省去每次提交时的文件表查找和引用计数
+        bool register_fixed(std::error_code &ec)
         {
-            // 创建 io_uring 实例
-            auto *ring = new io_uring();
-            if (io_uring_queue_init(32, ring, 0) < 0)
+            if (socket_fd_ < 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
-                delete ring;
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return false;
+            }
+            if (fixed_context_)
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
                 return false;
             }
 
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int slot = context.register_file(socket_fd_, ec);
+            if (slot < 0)
+                return false;
+            fixed_index_ = slot;
+            fixed_context_ = &context;
+            return true;
+        }
+
+        // 接管直接 accept 得到的固定文件槽位，此时连接没有普通描述符
+        void adopt_fixed(int slot, IoContext::Impl *context)
+        {
+            fixed_index_ = slot;
+            fixed_context_ = context;
+        }
+
+        // timeout 大于 0 时连接请求与一个链接的超时请求一起提交，到期未连上时 ec 为 timed_out
+        bool connect(const std::string &address, int port, std::chrono::milliseconds timeout, std::error_code &ec)
+        {
             // 创建 socket
             int socket_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
             if (socket_fd < 0)
             {
                 ec = std::make_error_code(std::errc::address_family_not_supported);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
@@ -58,124 +143,981 @@ namespace net
             {
                 ec = std::make_error_code(std::errc::invalid_argument);
                 close(socket_fd);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
             // 使用 io_uring 提交异步连接请求
-            io_uring_sqe *sqe = io_uring_get_sqe(ring);
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = context.get_sqe(timeout, ec);
+            if (!sqe)
+            {
+                close(socket_fd);
+                return false;
+            }
             io_uring_prep_connect(sqe, socket_fd, reinterpret_cast<sockaddr *>(&server_addr), sizeof(server_addr));
-            io_uring_submit(ring);
 
             // 等待连接完成
-            io_uring_cqe *cqe;
-            if (io_uring_wait_cqe(ring, &cqe) < 0)
+            SyncOperation op;
+            if (!context.wait(sqe, op, timeout, ec))
             {
-                ec = std::make_error_code(std::errc::io_error);
                 close(socket_fd);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
-            if (cqe->res < 0)
+            if (op.result < 0)
             {
-                ec = std::make_error_code(std::errc::connection_refused);
+                if (op.result == -ETIMEDOUT)
+                    ec = std::make_error_code(std::errc::timed_out);
+                else
+                    ec = std::make_error_code(std::errc::connection_refused);
                 close(socket_fd);
-                io_uring_cqe_seen(ring, cqe);
-                io_uring_queue_exit(ring);
-                delete ring;
                 return false;
             }
 
-            io_uring_cqe_seen(ring, cqe);
-
             // 连接成功
             socket_fd_ = socket_fd; // 保存 socket_fd
-            ring_ = ring;           // 保存 io_uring 实例
             return true;
         }
 
-        size_t write(const std::vector<uint8_t> &data, std::error_code &ec)
+        // 异步连接：创建套接字并提交 connect，完成时结果交给 op
+        // connect 的目标地址在提交时由内核复制，这里立即提交，栈上的地址随后即可释放
+        bool start_connect(const SocketAddr &address, IoOperation *op, std::error_code &ec)
         {
-            if (socket_fd_ < 0)
+            sockaddr_storage server_addr = {};
+            if (!start_connect(address, server_addr, op, ec))
+                return false;
+
+            // 请求已进入提交队列，之后的失败由完成事件报告
+            IoContext::current().impl_->submit(ec);
+            return true;
+        }
+
+        // 只准备连接请求，地址保存在调用者提供的 server_addr 中，由调用者提交
+        bool start_connect(const SocketAddr &address, sockaddr_storage &server_addr, IoOperation *op, std::error_code &ec)
+        {
+            if (socket_fd_ >= 0 || fixed_context_)
+            {
+                ec = std::make_error_code(std::errc::already_connected);
+                return false;
+            }
+
+            socklen_t addr_len = address.to_sockaddr(server_addr);
+            if (addr_len == 0)
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+
+            int socket_fd = ::socket(server_addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            if (socket_fd < 0)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return false;
+            }
+
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = context.get_sqe(ec);
+            if (!sqe)
+            {
+                close(socket_fd);
+                return false;
+            }
+            io_uring_prep_connect(sqe, socket_fd, reinterpret_cast<sockaddr *>(&server_addr), addr_len);
+            context.prepare(sqe, op);
+
+            // 请求已进入提交队列，套接字交给连接管理
+            socket_fd_ = socket_fd;
+            return true;
+        }
+
+        // 异步读取：提交后立即返回，完成时结果交给 op
+        bool start_read(MutableBuffer buffer, IoOperation *op, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = start_sqe(context, ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_read(sqe, target(context), buffer.data(), buffer.size(), 0);
+            apply_target(sqe, context);
+            context.prepare(sqe, op);
+            return true;
+        }
+
+        // 异步写入：提交后立即返回，完成时结果交给 op
+        bool start_write(ConstBuffer data, IoOperation *op, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            io_uring_sqe *sqe = start_sqe(context, ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_write(sqe, target(context), data.data(), data.size(), 0);
+            apply_target(sqe, context);
+            context.prepare(sqe, op);
+            return true;
+        }
+
+        size_t write(ConstBuffer data, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
                 ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
+            // 大块数据自动走零拷贝路径
+            if (zero_copy_threshold_ > 0 && data.size() >= zero_copy_threshold_)
+                return write_zero_copy(data, ec);
+
             // 使用 io_uring 提交异步写入请求
-            io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+            io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
             if (!sqe)
+                return 0;
+            io_uring_prep_write(sqe, fd, data.data(), data.size(), 0);
+            apply_target(sqe, context);
+
+            // 等待写入完成
+            SyncOperation op;
+            if (!context.wait(sqe, op, write_timeout_, ec))
+                return 0;
+
+            if (op.result < 0)
             {
-                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+                ec = std::error_code(-op.result, std::generic_category());
                 return 0;
             }
-            io_uring_prep_write(sqe, socket_fd_, data.data(), data.size(), 0);
-            io_uring_submit(ring_);
+            return static_cast<size_t>(op.result);
+        }
 
-            // 等待写入完成
-            io_uring_cqe *cqe = nullptr;
-            if (io_uring_wait_cqe(ring_, &cqe) < 0)
+        // 分散/聚集写入：多个缓冲区作为一个 IORING_OP_WRITEV 请求提交
+        size_t writev(const ConstBuffer *buffers, size_t count, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
-            if (cqe->res < 0)
+            IovecArray iov(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                iov[i].iov_base = const_cast<uint8_t *>(buffers[i].data());
+                iov[i].iov_len = buffers[i].size();
+            }
+
+            io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_writev(sqe, fd, iov.data(), static_cast<unsigned>(count), 0);
+            apply_target(sqe, context);
+            return wait_result(context, sqe, write_timeout_, ec);
+        }
+
+        // 分散读取：按顺序填充多个缓冲区
+        size_t readv(const MutableBuffer *buffers, size_t count, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
-                ec = std::error_code(-cqe->res, std::generic_category());
-                io_uring_cqe_seen(ring_, cqe);
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
-            size_t bytes_written = cqe->res;
-            io_uring_cqe_seen(ring_, cqe);
-            return bytes_written;
+            IovecArray iov(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                iov[i].iov_base = buffers[i].data();
+                iov[i].iov_len = buffers[i].size();
+            }
+
+            io_uring_sqe *sqe = context.get_sqe(read_timeout_, ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_readv(sqe, fd, iov.data(), static_cast<unsigned>(count), 0);
+            apply_target(sqe, context);
+            return wait_result(context, sqe, read_timeout_, ec);
         }
 
-        size_t read(std::vector<uint8_t> &buffer, std::error_code &ec)
+        // 零拷贝写入：内核直接引用用户内存发送，完成后再发出通知事件，
+        // 两个事件都到达后才返回，此后调用者可以安全地修改或释放 data
+        size_t write_zero_copy(ConstBuffer data, std::error_code &ec)
         {
-            if (socket_fd_ < 0)
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+
+            io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_send_zc(sqe, fd, data.data(), data.size(), MSG_NOSIGNAL, 0);
+            apply_target(sqe, context);
+
+            // 等待发送结果和缓冲区释放通知
+            SyncOperation op;
+            if (!context.wait(sqe, op, write_timeout_, ec))
+                return 0;
+
+            // 内核或套接字不支持零拷贝时关闭自动切换并退回普通写入
+            if (op.result == -EINVAL || op.result == -EOPNOTSUPP)
+            {
+                zero_copy_threshold_ = 0;
+                return write(data, ec);
+            }
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
+        }
+
+        void set_zero_copy_threshold(size_t bytes) { zero_copy_threshold_ = bytes; }
+
+        void set_read_timeout(std::chrono::milliseconds timeout) { read_timeout_ = timeout; }
+        void set_write_timeout(std::chrono::milliseconds timeout) { write_timeout_ = timeout; }
+
+        size_t read(MutableBuffer buffer, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
             {
                 ec = std::make_error_code(std::errc::bad_file_descriptor);
                 return 0;
             }
 
             // 使用 io_uring 提交异步读取请求
-            io_uring_sqe *sqe = io_uring_get_sqe(ring_);
+            io_uring_sqe *sqe = context.get_sqe(read_timeout_, ec);
             if (!sqe)
+                return 0;
+            io_uring_prep_read(sqe, fd, buffer.data(), buffer.size(), 0);
+            apply_target(sqe, context);
+
+            // 等待读取完成
+            SyncOperation op;
+            if (!context.wait(sqe, op, read_timeout_, ec))
+                return 0;
+
+            if (op.result < 0)
             {
-                ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+                ec = std::error_code(-op.result, std::generic_category());
                 return 0;
             }
-            io_uring_prep_read(sqe, socket_fd_, buffer.data(), buffer.size(), 0);
-            io_uring_submit(ring_);
+            return static_cast<size_t>(op.result);
+        }
+
+        ProvidedBuffer read(BufferRing &ring, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0 || !ring.impl_)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return ProvidedBuffer();
+            }
+
+            // 缓冲区组注册在创建它的线程的 io_uring 上
+            BufferRing::Impl &buffers = *ring.impl_;
+            if (buffers.context() != &IoContext::current())
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
+                return ProvidedBuffer();
+            }
+
+            // 提交 recv 请求，由内核在数据到达时从缓冲区组中挑选缓冲区
+            io_uring_sqe *sqe = context.get_sqe(read_timeout_, ec);
+            if (!sqe)
+                return ProvidedBuffer();
+            io_uring_prep_recv(sqe, fd, nullptr, buffers.buffer_size(), 0);
+            apply_target(sqe, context);
+            sqe->flags |= IOSQE_BUFFER_SELECT;
+            sqe->buf_group = buffers.group_id();
 
             // 等待读取完成
-            io_uring_cqe *cqe = nullptr;
-            if (io_uring_wait_cqe(ring_, &cqe) < 0)
+            SyncOperation op;
+            if (!context.wait(sqe, op, read_timeout_, ec))
+                return ProvidedBuffer();
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return ProvidedBuffer();
+            }
+            return buffers.take(op.result, op.flags);
+        }
+
+        // multishot 读取：首次调用时提交一个持续接收的 recv，之后只需从队列中取数据块
+        size_t read_multishot(BufferRing &ring, std::vector<ProvidedBuffer> &chunks, std::error_code &ec)
+        {
+            IoContext &context = IoContext::current();
+            if (target(*context.impl_) < 0 || !ring.impl_)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+
+            if (ring.impl_->context() != &context)
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
                 return 0;
             }
 
-            if (cqe->res < 0)
+            // 接收状态只在使用 multishot 的连接上分配
+            if (!recv_)
+                recv_.reset(new MultishotRecv());
+            MultishotRecv &state = *recv_;
+            if (state.armed && state.ring != ring.impl_)
             {
-                ec = std::error_code(-cqe->res, std::generic_category());
-                io_uring_cqe_seen(ring_, cqe);
+                ec = std::make_error_code(std::errc::invalid_argument);
                 return 0;
             }
 
-            size_t bytes_read = cqe->res;
-            io_uring_cqe_seen(ring_, cqe);
-            return bytes_read;
+            while (state.chunks.empty())
+            {
+                if (state.eof)
+                    return 0;
+                if (state.error)
+                {
+                    ec = state.error;
+                    state.error.clear();
+                    return 0;
+                }
+                if (!state.armed && !arm_multishot(state, *ring.impl_, ec))
+                    return 0;
+
+                // multishot 请求不能链接超时，读取期限由等待本身计时
+                auto ready = [&state] { return !state.chunks.empty() || !state.armed || state.error; };
+                if (!context.impl_->wait_until(ready, read_timeout_, ec))
+                    return 0;
+            }
+
+            size_t count = 0;
+            while (!state.chunks.empty())
+            {
+                chunks.push_back(std::move(state.chunks.front()));
+                state.chunks.pop_front();
+                ++count;
+            }
+            return count;
+        }
+
+        // 使用注册过的固定缓冲区写入，内核不再逐次固定用户页面
+        size_t write_fixed(const FixedBuffer &buffer, size_t size, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (!check_fixed(buffer, size, context, ec))
+                return 0;
+
+            io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_write_fixed(sqe, fd, buffer.data(), size, 0, BufferPool::Impl::kBufferIndex);
+            apply_target(sqe, context);
+
+            SyncOperation op;
+            if (!context.wait(sqe, op, write_timeout_, ec))
+                return 0;
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
+        }
+
+        // 读取数据到注册过的固定缓冲区，最多读取 buffer.capacity() 个字节
+        size_t read_fixed(FixedBuffer &buffer, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (!check_fixed(buffer, buffer.capacity(), context, ec))
+                return 0;
+
+            io_uring_sqe *sqe = context.get_sqe(read_timeout_, ec);
+            if (!sqe)
+                return 0;
+            io_uring_prep_read_fixed(sqe, fd, buffer.data(), buffer.capacity(), 0, BufferPool::Impl::kBufferIndex);
+            apply_target(sqe, context);
+
+            SyncOperation op;
+            if (!context.wait(sqe, op, read_timeout_, ec))
+                return 0;
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
+        }
+
+        // 文件到套接字的零拷贝传输：每块由两个链接的 IORING_OP_SPLICE 完成，先把文件页面移入管道，
+        // 再从管道移到套接字，数据不经过用户空间，每块只需一次提交
+        // 文件不支持 splice 时改用 sendfile；文件在 length 之前结束时返回已发送的字节数
+        size_t send_file(int file_fd, uint64_t offset, size_t length, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            int fd = target(context);
+            if (fd < 0 || file_fd < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+            if (!pipe_.open(ec))
+                return 0;
+
+            size_t sent = 0;
+            size_t queued = 0; // 已从文件移入管道的字节数，管道中还有 queued - sent 个字节
+            while (sent < length)
+            {
+                SyncOperation fill;
+                SyncOperation drain;
+                size_t in_pipe = queued - sent;
+                size_t chunk = 0;
+
+                // 管道已空时先准备读取文件的请求，并与随后的发送请求链接，读取不足一块时链被打断、发送被取消
+                if (in_pipe == 0)
+                {
+                    chunk = std::min(length - queued, pipe_.size());
+                    if (!context.reserve(3, ec))
+                        break;
+                    io_uring_sqe *sqe = context.get_sqe(ec);
+                    if (!sqe)
+                        break;
+                    io_uring_prep_splice(sqe, file_fd, static_cast<int64_t>(offset + queued), pipe_.write_fd(), -1,
+                                         static_cast<unsigned>(chunk), SPLICE_F_MOVE);
+                    sqe->flags |= IOSQE_IO_LINK;
+                    context.prepare(sqe, &fill);
+                    in_pipe = chunk;
+                }
+
+                // 读取文件时已预留了整条链的位置，这里只有单独发送管道中的残留数据时才可能失败
+                io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
+                if (!sqe)
+                    break;
+                io_uring_prep_splice(sqe, pipe_.read_fd(), -1, fd, -1, static_cast<unsigned>(in_pipe),
+                                     sent + in_pipe < length ? SPLICE_F_MORE : 0);
+                apply_target(sqe, context);
+                // 发送的等待失败时也要等读取请求结束，fill 在栈上
+                bool drained = context.wait(sqe, drain, write_timeout_, ec);
+                std::error_code fill_ec;
+                if (chunk > 0 && !context.wait(fill, fill_ec) && drained)
+                    ec = fill_ec;
+                if (ec)
+                {
+                    pipe_.close();
+                    break;
+                }
+
+                if (chunk > 0)
+                {
+                    if (fill.result < 0)
+                    {
+                        // 文件系统不支持 splice 时，从出错的位置改用 sendfile
+                        if (fill.result == -EINVAL || fill.result == -EOPNOTSUPP)
+                            return sent + send_file_fallback(file_fd, offset + sent, length - sent, ec);
+                        ec = std::error_code(-fill.result, std::generic_category());
+                        break;
+                    }
+                    queued += static_cast<size_t>(fill.result);
+                    if (static_cast<size_t>(fill.result) < chunk)
+                    {
+                        // 文件已经结束，或者只读到一部分，发送请求没有执行
+                        if (fill.result == 0)
+                            break;
+                        continue;
+                    }
+                }
+
+                // 非阻塞套接字的发送缓冲区已满，等可写后再发送管道中的数据
+                if (drain.result == -EAGAIN)
+                {
+                    if (!wait_writable(context, ec))
+                    {
+                        pipe_.close();
+                        break;
+                    }
+                    continue;
+                }
+
+                if (drain.result <= 0)
+                {
+                    ec = drain.result < 0 ? std::error_code(-drain.result, std::generic_category())
+                                          : std::make_error_code(std::errc::broken_pipe);
+                    // 管道中残留的数据不能留给下一次传输
+                    pipe_.close();
+                    break;
+                }
+                sent += static_cast<size_t>(drain.result);
+            }
+            return sent;
+        }
+
+        // 双向转发：每个方向一个管道，两个方向同时进行，由事件循环驱动直到两个方向都结束
+        static SpliceStats splice_bidirectional(Impl &a, Impl &b, std::error_code &ec)
+        {
+            IoContext::Impl &context = *IoContext::current().impl_;
+            if (a.target(context) < 0 || b.target(context) < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return SpliceStats();
+            }
+
+            SpliceDirection forward(a, b, context);
+            SpliceDirection backward(b, a, context);
+            if (!forward.open(ec) || !backward.open(ec))
+                return SpliceStats();
+            forward.start();
+            backward.start();
+
+            auto finished = [&]
+            {
+                return (forward.done() && backward.done()) || forward.error() || backward.error();
+            };
+            context.wait_until(finished, ec);
+
+            // 一个方向出错时取消另一个方向仍在进行的请求，等它们全部完成后才能释放操作对象
+            forward.stop();
+            backward.stop();
+            context.settle([&] { return forward.idle() && backward.idle(); });
+
+            // 半关闭请求可能还在提交队列中，返回前提交
+            std::error_code submit_ec;
+            context.submit(submit_ec);
+
+            if (!ec)
+                ec = forward.error() ? forward.error() : backward.error();
+            SpliceStats stats;
+            stats.a_to_b = forward.bytes();
+            stats.b_to_a = backward.bytes();
+            return stats;
         }
 
     private:
+        // 双向转发中的一个方向：数据从 in 经管道移到 out，不经过用户空间
+        // 每轮把管道中的数据发往 out，并链接等待 in 可读和下一次读取，一次提交完成一轮；
+        // 发送不完整时链被打断，后面的请求被取消，先补发剩余的数据
+        // 套接字可能是非阻塞的，splice 在没有数据或没有空间时返回 EAGAIN，因此读取前先等待可读
+        class SpliceDirection
+        {
+        public:
+            SpliceDirection(Impl &in, Impl &out, IoContext::Impl &context) : in_(in), out_(out), context_(context)
+            {
+                poll_out_.complete = &SpliceDirection::on_poll;
+                drain_.complete = &SpliceDirection::on_drain;
+                poll_in_.complete = &SpliceDirection::on_poll;
+                fill_.complete = &SpliceDirection::on_fill;
+                for (Operation *op : {&poll_out_, &drain_, &poll_in_, &fill_})
+                    op->direction = this;
+            }
+
+            SpliceDirection(const SpliceDirection &) = delete;
+            SpliceDirection &operator=(const SpliceDirection &) = delete;
+
+            bool open(std::error_code &ec) { return pipe_.open(ec); }
+            void start() { submit(false); }
+
+            // 不再提交新的请求，并取消仍在进行的请求
+            void stop()
+            {
+                done_ = true;
+                for (Operation *op : {&poll_out_, &drain_, &poll_in_, &fill_})
+                {
+                    if (op->pending > 0)
+                        context_.cancel(op);
+                }
+            }
+
+            bool done() const { return done_; }
+            bool idle() const { return poll_out_.pending + drain_.pending + poll_in_.pending + fill_.pending == 0; }
+            const std::error_code &error() const { return error_; }
+            uint64_t bytes() const { return bytes_; }
+
+        private:
+            struct Operation : IoOperation
+            {
+                SpliceDirection *direction = nullptr;
+                unsigned pending = 0;
+            };
+
+            // 管道中有数据时先发送，wait_writable 为 true 时发送前等待可写；之后等待可读并读取下一块
+            void submit(bool wait_writable)
+            {
+                std::error_code ec;
+                if (!context_.reserve(4, ec))
+                {
+                    fail(ec);
+                    return;
+                }
+
+                int out_fd = out_.target(context_);
+                io_uring_sqe *sqe = nullptr;
+                if (in_pipe_ > 0)
+                {
+                    if (wait_writable)
+                    {
+                        if (!(sqe = next_sqe(sqe)))
+                            return;
+                        io_uring_prep_poll_add(sqe, out_fd, POLLOUT);
+                        link(sqe, out_, poll_out_);
+                    }
+                    if (!(sqe = next_sqe(sqe)))
+                        return;
+                    io_uring_prep_splice(sqe, pipe_.read_fd(), -1, out_fd, -1, static_cast<unsigned>(in_pipe_), SPLICE_F_MOVE);
+                    link(sqe, out_, drain_);
+                }
+
+                int in_fd = in_.target(context_);
+                if (!(sqe = next_sqe(sqe)))
+                    return;
+                io_uring_prep_poll_add(sqe, in_fd, POLLIN);
+                link(sqe, in_, poll_in_);
+
+                unsigned flags = SPLICE_F_MOVE;
+                if (in_.fixed_context_ == &context_)
+                    flags |= SPLICE_F_FD_IN_FIXED;
+                if (!(sqe = next_sqe(sqe)))
+                    return;
+                io_uring_prep_splice(sqe, in_fd, -1, pipe_.write_fd(), -1, static_cast<unsigned>(pipe_.size()), flags);
+                context_.prepare(sqe, &fill_);
+                ++fill_.pending;
+            }
+
+            // 取链中的下一个 SQE；取不到时让已准备的请求单独结束，并停止这个方向
+            io_uring_sqe *next_sqe(io_uring_sqe *prev)
+            {
+                std::error_code ec;
+                io_uring_sqe *sqe = context_.get_sqe(ec);
+                if (!sqe)
+                {
+                    if (prev)
+                        prev->flags &= ~IOSQE_IO_LINK;
+                    fail(ec);
+                }
+                return sqe;
+            }
+
+            // 准备链中的一个请求，stream 是请求操作的连接
+            void link(io_uring_sqe *sqe, const Impl &stream, Operation &op)
+            {
+                stream.apply_target(sqe, context_);
+                sqe->flags |= IOSQE_IO_LINK;
+                context_.prepare(sqe, &op);
+                ++op.pending;
+            }
+
+            static void on_poll(IoOperation *op, int result, unsigned)
+            {
+                auto *self = static_cast<Operation *>(op)->direction;
+                --static_cast<Operation *>(op)->pending;
+                if (!self->done_ && result < 0 && result != -ECANCELED)
+                    self->fail(std::error_code(-result, std::generic_category()));
+            }
+
+            static void on_drain(IoOperation *op, int result, unsigned)
+            {
+                auto *self = static_cast<Operation *>(op)->direction;
+                --self->drain_.pending;
+                if (self->done_ || result == -ECANCELED)
+                    return;
+                if (result == -EAGAIN)
+                {
+                    // 非阻塞套接字没有发送空间，等可写后重发
+                    self->submit(true);
+                    return;
+                }
+                if (result <= 0)
+                {
+                    self->fail(result < 0 ? std::error_code(-result, std::generic_category())
+                                          : std::make_error_code(std::errc::broken_pipe));
+                    return;
+                }
+
+                self->bytes_ += static_cast<uint64_t>(result);
+                self->in_pipe_ -= static_cast<size_t>(result);
+                if (self->in_pipe_ > 0)
+                    self->submit(false);
+            }
+
+            static void on_fill(IoOperation *op, int result, unsigned)
+            {
+                auto *self = static_cast<Operation *>(op)->direction;
+                --self->fill_.pending;
+                // 链中前面的请求没有完整完成时读取被取消，由该请求的完成处理继续
+                if (self->done_ || result == -ECANCELED)
+                    return;
+                if (result == -EAGAIN)
+                {
+                    self->submit(false);
+                    return;
+                }
+                if (result < 0)
+                {
+                    self->fail(std::error_code(-result, std::generic_category()));
+                    return;
+                }
+                if (result == 0)
+                {
+                    self->finish();
+                    return;
+                }
+
+                self->in_pipe_ += static_cast<size_t>(result);
+                self->submit(false);
+            }
+
+            // in 已经关闭，管道中的数据也已发完：关闭 out 的写方向，对端随后读到 EOF
+            void finish()
+            {
+                done_ = true;
+                std::error_code ec;
+                io_uring_sqe *sqe = context_.get_sqe(ec);
+                if (!sqe)
+                {
+                    fail(ec);
+                    return;
+                }
+                io_uring_prep_shutdown(sqe, out_.target(context_), SHUT_WR);
+                out_.apply_target(sqe, context_);
+                context_.prepare(sqe, nullptr);
+            }
+
+            void fail(const std::error_code &error)
+            {
+                if (!error_)
+                    error_ = error;
+                done_ = true;
+            }
+
+            Impl &in_;
+            Impl &out_;
+            IoContext::Impl &context_;
+            SplicePipe pipe_;
+            Operation poll_out_;
+            Operation drain_;
+            Operation poll_in_;
+            Operation fill_;
+            size_t in_pipe_ = 0;
+            uint64_t bytes_ = 0;
+            std::error_code error_;
+            bool done_ = false;
+        };
+
+        // 不支持 splice 的文件用 sendfile 发送；非阻塞套接字的发送缓冲区满时等待可写
+        size_t send_file_fallback(int file_fd, uint64_t offset, size_t length, std::error_code &ec)
+        {
+            if (socket_fd_ < 0)
+            {
+                ec = std::make_error_code(std::errc::operation_not_supported);
+                return 0;
+            }
+
+            IoContext::Impl &context = *IoContext::current().impl_;
+            size_t sent = 0;
+            while (sent < length)
+            {
+                off_t file_offset = static_cast<off_t>(offset + sent);
+                ssize_t bytes_sent = ::sendfile(socket_fd_, file_fd, &file_offset, length - sent);
+                if (bytes_sent > 0)
+                {
+                    sent += static_cast<size_t>(bytes_sent);
+                    continue;
+                }
+                if (bytes_sent == 0)
+                    break;
+                if (errno == EINTR)
+                    continue;
+                if (errno != EAGAIN)
+                {
+                    ec = std::error_code(errno, std::generic_category());
+                    break;
+                }
+                if (!wait_writable(context, ec))
+                    break;
+            }
+            return sent;
+        }
+
+        // 通过 io_uring 等待套接字可写，受写入期限约束
+        bool wait_writable(IoContext::Impl &context, std::error_code &ec)
+        {
+            io_uring_sqe *sqe = context.get_sqe(write_timeout_, ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_poll_add(sqe, target(context), POLLOUT);
+            apply_target(sqe, context);
+
+            SyncOperation op;
+            if (!context.wait(sqe, op, write_timeout_, ec))
+                return false;
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return false;
+            }
+            return true;
+        }
+
+        struct MultishotRecv : IoOperation
+        {
+            BufferRing::Impl *ring = nullptr;
+            IoContext *context = nullptr;
+            std::deque<ProvidedBuffer> chunks;
+            std::error_code error;
+            bool armed = false;
+            bool eof = false;
+        };
+
+        // multishot recv 的完成回调，每个数据块产生一个完成事件
+        static void on_recv(IoOperation *op, int result, unsigned flags)
+        {
+            auto *state = static_cast<MultishotRecv *>(op);
+            ProvidedBuffer buffer = state->ring->take(result > 0 ? result : 0, flags);
+            if (result > 0)
+                state->chunks.push_back(std::move(buffer));
+            else if (result == 0)
+                state->eof = true;
+            else if (result != -ECANCELED)
+                state->error = std::error_code(-result, std::generic_category());
+
+            // 连接关闭或缓冲区耗尽（ENOBUFS）时内核终止请求，归还缓冲区后可重新提交
+            if (!(flags & IORING_CQE_F_MORE))
+                state->armed = false;
+        }
+
+        bool arm_multishot(MultishotRecv &state, BufferRing::Impl &ring, std::error_code &ec)
+        {
+            IoContext &context = IoContext::current();
+            io_uring_sqe *sqe = context.impl_->get_sqe(ec);
+            if (!sqe)
+                return false;
+            io_uring_prep_recv_multishot(sqe, target(*context.impl_), nullptr, 0, 0);
+            apply_target(sqe, *context.impl_);
+            sqe->flags |= IOSQE_BUFFER_SELECT;
+            sqe->buf_group = ring.group_id();
+
+            state.complete = &Impl::on_recv;
+            state.ring = &ring;
+            state.context = &context;
+            state.armed = true;
+            context.impl_->prepare(sqe, &state);
+            return true;
+        }
+
+        // 取消仍在进行的 multishot recv，并等待其最后一个完成事件
+        void cancel_multishot()
+        {
+            if (!recv_ || !recv_->armed)
+                return;
+
+            MultishotRecv &state = *recv_;
+            state.context->impl_->cancel(&state, [&state] { return !state.armed; });
+        }
+
+        // iovec 数组，常见的少量缓冲区直接放在栈上，请求完成前保持有效
+        class IovecArray
+        {
+        public:
+            static constexpr size_t kInlineCount = 8;
+
+            explicit IovecArray(size_t count)
+            {
+                if (count > kInlineCount)
+                    heap_.resize(count);
+            }
+
+            iovec *data() { return heap_.empty() ? inline_ : heap_.data(); }
+            iovec &operator[](size_t i) { return data()[i]; }
+
+        private:
+            iovec inline_[kInlineCount] = {};
+            std::vector<iovec> heap_;
+        };
+
+        // 异步操作共用的检查：连接有效时返回一个 SQE
+        io_uring_sqe *start_sqe(IoContext::Impl &context, std::error_code &ec) const
+        {
+            if (target(context) < 0)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return nullptr;
+            }
+            return context.get_sqe(ec);
+        }
+
+        // 提交请求并等待完成，返回传输的字节数
+        static size_t wait_result(IoContext::Impl &context, io_uring_sqe *sqe, std::chrono::milliseconds timeout,
+                                  std::error_code &ec)
+        {
+            SyncOperation op;
+            if (!context.wait(sqe, op, timeout, ec))
+                return 0;
+
+            if (op.result < 0)
+            {
+                ec = std::error_code(-op.result, std::generic_category());
+                return 0;
+            }
+            return static_cast<size_t>(op.result);
+        }
+
+        // 固定缓冲区必须来自注册在当前线程 io_uring 上的缓冲区池
+        static bool check_fixed(const FixedBuffer &buffer, size_t size, const IoContext::Impl &context, std::error_code &ec)
+        {
+            if (!buffer || size > buffer.capacity())
+            {
+                ec = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            if (!buffer.pool() || buffer.pool()->context()->impl_ != &context)
+            {
+                ec = std::make_error_code(std::errc::operation_not_permitted);
+                return false;
+            }
+            return true;
+        }
+
+        // 在注册所在线程的 io_uring 上使用固定文件索引，其他线程使用普通描述符
+        int target(const IoContext::Impl &context) const
+        {
+            return fixed_context_ == &context ? fixed_index_ : socket_fd_;
+        }
+
+        void apply_target(io_uring_sqe *sqe, const IoContext::Impl &context) const
+        {
+            if (fixed_context_ == &context)
+                sqe->flags |= IOSQE_FIXED_FILE;
+        }
+
         int socket_fd_ = -1;
-        io_uring *ring_ = nullptr;
+        int fixed_index_ = -1;
+        IoContext::Impl *fixed_context_ = nullptr;
+        size_t zero_copy_threshold_ = 0;
+        std::chrono::milliseconds read_timeout_{0};
+        std::chrono::milliseconds write_timeout_{0};
+        std::unique_ptr<MultishotRecv> recv_;
+        SplicePipe pipe_; ///< send_file 使用的管道，首次调用时创建
     };
 
 } // namespace net
@@ -2,11 +2,16 @@
 #define MAC_TCP_STREAM_H
 
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <cstring>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
 #include <netinet/in.h>
 #include <stdexcept>
+#include <chrono>
 
 namespace net
 {
@@ -15,6 +20,7 @@ namespace net
     {
     public:
         Impl() : socket_fd_(-1) {}
+        Impl(int socket_fd) : socket_fd_(socket_fd) {}
 
         ~Impl()
         {
@@ -24,8 +30,8 @@ namespace net
             }
         }
 
-        // 连接到远程地址
-        bool connect(const std::string &address, int port, std::error_code &ec)
+        // 连接到远程地址，timeout 大于 0 时以非阻塞方式连接并用 poll 等待
+        bool connect(const std::string &address, int port, std::chrono::milliseconds timeout, std::error_code &ec)
         {
             // 创建套接字
             socket_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
@@ -48,42 +54,232 @@ namespace net
             }
 
             // 连接到服务器
-            if (::connect(socket_fd_, reinterpret_cast<sockaddr *>(&server_addr), sizeof(server_addr)) == -1)
-            {
+            int flags = fcntl(socket_fd_, F_GETFL, 0);
+            if (timeout.count() > 0)
+                fcntl(socket_fd_, F_SETFL, flags | O_NONBLOCK);
+            bool connected = ::connect(socket_fd_, reinterpret_cast<sockaddr *>(&server_addr), sizeof(server_addr)) == 0;
+            if (!connected && timeout.count() > 0 && errno == EINPROGRESS)
+                connected = wait_connected(timeout, ec);
+            else if (!connected)
                 ec.assign(errno, std::system_category());
+            if (!connected)
+            {
                 close(socket_fd_);
                 socket_fd_ = -1;
                 return false;
             }
+            if (timeout.count() > 0)
+                fcntl(socket_fd_, F_SETFL, flags);
 
             return true;
         }
 
+        // 读写期限由套接字的 SO_RCVTIMEO/SO_SNDTIMEO 实现
+        void set_read_timeout(std::chrono::milliseconds timeout) { set_timeout(SO_RCVTIMEO, timeout); }
+        void set_write_timeout(std::chrono::milliseconds timeout) { set_timeout(SO_SNDTIMEO, timeout); }
+
+        // 该平台没有固定文件表
+        bool register_fixed(std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
         // 写数据
-        size_t write(const std::vector<uint8_t> &data, std::error_code &ec)
+        size_t write(ConstBuffer data, std::error_code &ec)
         {
             ssize_t bytes_sent = ::send(socket_fd_, data.data(), data.size(), 0);
             if (bytes_sent == -1)
             {
-                ec.assign(errno, std::system_category());
+                ec = transfer_error();
                 return 0;
             }
             return static_cast<size_t>(bytes_sent);
         }
 
+        // 该平台没有零拷贝发送，退化为普通写入
+        size_t write_zero_copy(ConstBuffer data, std::error_code &ec)
+        {
+            return write(data, ec);
+        }
+
+        void set_zero_copy_threshold(size_t) {}
+
+        // 该平台没有 splice
+        static SpliceStats splice_bidirectional(Impl &, Impl &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return SpliceStats();
+        }
+
+        // 用 sendfile 发送文件，len 为 0 表示发送到文件末尾，所以长度为 0 时不调用
+        size_t send_file(int file_fd, uint64_t offset, size_t length, std::error_code &ec)
+        {
+            size_t sent = 0;
+            while (sent < length)
+            {
+                off_t bytes = static_cast<off_t>(length - sent);
+                int result = ::sendfile(file_fd, socket_fd_, static_cast<off_t>(offset + sent), &bytes, nullptr, 0);
+                sent += static_cast<size_t>(bytes);
+                if (result == -1)
+                {
+                    // 被信号中断或发送超时前已经发出部分数据时继续
+                    if (errno == EINTR || (errno == EAGAIN && bytes > 0))
+                        continue;
+                    ec = transfer_error();
+                    break;
+                }
+                if (bytes == 0)
+                    break;
+            }
+            return sent;
+        }
+
         // 读数据
-        size_t read(std::vector<uint8_t> &buffer, std::error_code &ec)
+        size_t read(MutableBuffer buffer, std::error_code &ec)
         {
             ssize_t bytes_received = ::recv(socket_fd_, buffer.data(), buffer.size(), 0);
             if (bytes_received == -1)
             {
-                ec.assign(errno, std::system_category());
+                ec = transfer_error();
                 return 0;
             }
             return static_cast<size_t>(bytes_received);
         }
 
+        // 该平台没有内核提供的缓冲区环
+        ProvidedBuffer read(BufferRing &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return ProvidedBuffer();
+        }
+
+        size_t read_multishot(BufferRing &, std::vector<ProvidedBuffer> &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 该平台没有固定缓冲区
+        size_t write_fixed(const FixedBuffer &, size_t, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        size_t read_fixed(FixedBuffer &, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 分散/聚集写入
+        size_t writev(const ConstBuffer *buffers, size_t count, std::error_code &ec)
+        {
+            std::vector<iovec> iov(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                iov[i].iov_base = const_cast<uint8_t *>(buffers[i].data());
+                iov[i].iov_len = buffers[i].size();
+            }
+
+            ssize_t bytes_sent = ::writev(socket_fd_, iov.data(), static_cast<int>(count));
+            if (bytes_sent == -1)
+            {
+                ec = transfer_error();
+                return 0;
+            }
+            return static_cast<size_t>(bytes_sent);
+        }
+
+        // 分散读取
+        size_t readv(const MutableBuffer *buffers, size_t count, std::error_code &ec)
+        {
+            std::vector<iovec> iov(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                iov[i].iov_base = buffers[i].data();
+                iov[i].iov_len = buffers[i].size();
+            }
+
+            ssize_t bytes_received = ::readv(socket_fd_, iov.data(), static_cast<int>(count));
+            if (bytes_received == -1)
+            {
+                ec = transfer_error();
+                return 0;
+            }
+            return static_cast<size_t>(bytes_received);
+        }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_read(MutableBuffer, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_write(ConstBuffer, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_connect(const SocketAddr &, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_connect(const SocketAddr &, sockaddr_storage &, IoOperation *, std::error_code &ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
     private:
+        // 等待非阻塞连接完成，超时时 ec 为 timed_out
+        bool wait_connected(std::chrono::milliseconds timeout, std::error_code &ec)
+        {
+            pollfd pfd = {socket_fd_, POLLOUT, 0};
+            int ready = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+            if (ready == 0)
+            {
+                ec = std::make_error_code(std::errc::timed_out);
+                return false;
+            }
+            if (ready < 0)
+            {
+                ec.assign(errno, std::system_category());
+                return false;
+            }
+
+            int error = 0;
+            socklen_t len = sizeof(error);
+            getsockopt(socket_fd_, SOL_SOCKET, SO_ERROR, &error, &len);
+            if (error != 0)
+            {
+                ec.assign(error, std::system_category());
+                return false;
+            }
+            return true;
+        }
+
+        // 读写失败时的错误码，超过 SO_RCVTIMEO/SO_SNDTIMEO 时内核返回 EAGAIN
+        static std::error_code transfer_error()
+        {
+            if (errno == EAGAIN)
+                return std::make_error_code(std::errc::timed_out);
+            return std::error_code(errno, std::system_category());
+        }
+
+        void set_timeout(int option, std::chrono::milliseconds timeout)
+        {
+            timeval tv = {};
+            tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+            tv.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+            setsockopt(socket_fd_, SOL_SOCKET, option, &tv, sizeof(tv));
+        }
+
         int socket_fd_;
     };
 
@@ -15,10 +15,12 @@ namespace net
     // TcpStream 类的构造和析构
     TcpStream::TcpStream() : impl_(new Impl()) {}
 
+#if defined(_WIN32)
     TcpStream::TcpStream(SOCKET socket) : impl_(new Impl(socket)) {}
+#else
+    TcpStream::TcpStream(int socket_fd) : impl_(new Impl(socket_fd)) {}
+#endif
 
-	TcpStream::TcpStream(int socket_fd, io_uring *ring) : impl_(new Impl(socket_fd, ring)) {}
-	
     TcpStream::~TcpStream()
     {
         delete impl_;
@@ -43,17 +45,43 @@ namespace net
 
     // 连接到远程主机
     std::optional<TcpStream> TcpStream::connect(const std::string& address, int port, std::error_code& ec)
+    {
+        return connect(address, port, std::chrono::milliseconds(0), ec);
+    }
+
+    std::optional<TcpStream> TcpStream::connect(const std::string& address, int port, std::chrono::milliseconds timeout, std::error_code& ec)
     {
         TcpStream stream;
-        if (stream.impl_->connect(address, port, ec))
+        if (stream.impl_->connect(address, port, timeout, ec))
         {
             return stream;
         }
         return std::nullopt;
     }
 
+    // 注册为固定文件
+    bool TcpStream::register_fixed(std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->register_fixed(ec);
+    }
+
     // 写数据
     size_t TcpStream::write(const std::vector<uint8_t>& data, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->write(ConstBuffer(data), ec);
+    }
+
+    size_t TcpStream::write(ConstBuffer data, std::error_code& ec)
     {
         if (!impl_)
         {
@@ -63,8 +91,102 @@ namespace net
         return impl_->write(data, ec);
     }
 
+    // 循环写入全部数据
+    size_t TcpStream::write_all(ConstBuffer data, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+
+        size_t total = 0;
+        while (total < data.size())
+        {
+            size_t bytes_written = impl_->write(data.advance(total), ec);
+            if (ec)
+                break;
+            if (bytes_written == 0)
+            {
+                ec = std::make_error_code(std::errc::broken_pipe);
+                break;
+            }
+            total += bytes_written;
+        }
+        return total;
+    }
+
+    // 零拷贝写数据
+    size_t TcpStream::write_zero_copy(const std::vector<uint8_t>& data, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->write_zero_copy(ConstBuffer(data), ec);
+    }
+
+    // 零拷贝发送文件
+    size_t TcpStream::send_file(int file_fd, uint64_t offset, size_t length, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->send_file(file_fd, offset, length, ec);
+    }
+
+    // 设置零拷贝阈值
+    void TcpStream::set_zero_copy_threshold(size_t bytes)
+    {
+        if (impl_)
+        {
+            impl_->set_zero_copy_threshold(bytes);
+        }
+    }
+
+    // 设置读写期限
+    void TcpStream::set_read_timeout(std::chrono::milliseconds timeout)
+    {
+        if (impl_)
+        {
+            impl_->set_read_timeout(timeout);
+        }
+    }
+
+    void TcpStream::set_write_timeout(std::chrono::milliseconds timeout)
+    {
+        if (impl_)
+        {
+            impl_->set_write_timeout(timeout);
+        }
+    }
+
+    // 聚集写数据
+    size_t TcpStream::writev(const ConstBuffer* buffers, size_t count, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->writev(buffers, count, ec);
+    }
+
     // 读数据
     size_t TcpStream::read(std::vector<uint8_t>& buffer, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->read(MutableBuffer(buffer), ec);
+    }
+
+    size_t TcpStream::read(MutableBuffer buffer, std::error_code& ec)
     {
         if (!impl_)
         {
@@ -73,4 +195,140 @@ namespace net
         }
         return impl_->read(buffer, ec);
     }
-}
\ No newline at end of file
+
+    // 循环读取直到填满缓冲区
+    size_t TcpStream::read_exact(MutableBuffer buffer, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+
+        size_t total = 0;
+        while (total < buffer.size())
+        {
+            size_t bytes_read = impl_->read(buffer.advance(total), ec);
+            if (ec)
+                break;
+            if (bytes_read == 0)
+            {
+                // 对端在缓冲区填满之前关闭了连接
+                ec = std::make_error_code(std::errc::connection_reset);
+                break;
+            }
+            total += bytes_read;
+        }
+        return total;
+    }
+
+    // 分散读数据
+    size_t TcpStream::readv(const MutableBuffer* buffers, size_t count, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->readv(buffers, count, ec);
+    }
+
+    // 读数据到内核挑选的缓冲区
+    ProvidedBuffer TcpStream::read(BufferRing& ring, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return ProvidedBuffer();
+        }
+        return impl_->read(ring, ec);
+    }
+
+    // 持续读数据到内核挑选的缓冲区
+    size_t TcpStream::read_multishot(BufferRing& ring, std::vector<ProvidedBuffer>& chunks, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->read_multishot(ring, chunks, ec);
+    }
+
+    // 使用固定缓冲区写数据
+    size_t TcpStream::write_fixed(const FixedBuffer& buffer, size_t size, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->write_fixed(buffer, size, ec);
+    }
+
+    // 读数据到固定缓冲区
+    size_t TcpStream::read_fixed(FixedBuffer& buffer, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return 0;
+        }
+        return impl_->read_fixed(buffer, ec);
+    }
+
+    // 提交异步读取
+    bool TcpStream::start_read(MutableBuffer buffer, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_read(buffer, op, ec);
+    }
+
+    // 提交异步写入
+    bool TcpStream::start_write(ConstBuffer data, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_write(data, op, ec);
+    }
+
+    // 提交异步连接
+    bool TcpStream::start_connect(const SocketAddr& address, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_connect(address, op, ec);
+    }
+
+    // 准备异步连接，由调用者提交
+    bool TcpStream::start_connect(const SocketAddr& address, sockaddr_storage& storage, IoOperation* op, std::error_code& ec)
+    {
+        if (!impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return false;
+        }
+        return impl_->start_connect(address, storage, op, ec);
+    }
+
+    // 双向 splice 转发
+    SpliceStats splice_bidirectional(TcpStream& a, TcpStream& b, std::error_code& ec)
+    {
+        if (!a.impl_ || !b.impl_)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return SpliceStats();
+        }
+        return TcpStream::Impl::splice_bidirectional(*a.impl_, *b.impl_, ec);
+    }
+}
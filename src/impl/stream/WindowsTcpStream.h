@@ -3,10 +3,16 @@
 
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <mswsock.h>
+#include <io.h>
+#include <algorithm>
 #include <stdexcept>
+#include <chrono>
 #include <system_error>
+#include <vector>
 
 #pragma comment(lib, "Ws2_32.lib")
+#pragma comment(lib, "Mswsock.lib")
 
 namespace net
 {
@@ -25,8 +31,8 @@ namespace net
             }
         }
 
-        // 连接到远程地址
-        bool connect(const std::string& address, int port, std::error_code& ec)
+        // 连接到远程地址，timeout 大于 0 时以非阻塞方式连接并用 select 等待
+        bool connect(const std::string& address, int port, std::chrono::milliseconds timeout, std::error_code& ec)
         {
             WSADATA wsaData;
             if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
@@ -54,9 +60,18 @@ namespace net
             serverAddr.sin_port = htons(port);
             inet_pton(AF_INET, address.c_str(), &serverAddr.sin_addr);
 
-            if (::connect(socket_, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR)
+            u_long nonblocking = timeout.count() > 0 ? 1 : 0;
+            ioctlsocket(socket_, FIONBIO, &nonblocking);
+            bool connected = ::connect(socket_, (sockaddr*)&serverAddr, sizeof(serverAddr)) != SOCKET_ERROR;
+            if (!connected && timeout.count() > 0 && WSAGetLastError() == WSAEWOULDBLOCK)
+                connected = wait_connected(timeout, ec);
+            nonblocking = 0;
+            ioctlsocket(socket_, FIONBIO, &nonblocking);
+
+            if (!connected)
             {
-                ec = std::make_error_code(std::errc::connection_refused);
+                if (!ec)
+                    ec = std::make_error_code(std::errc::connection_refused);
                 closesocket(socket_);
                 socket_ = INVALID_SOCKET;  // 重置套接字状态
                 return false;
@@ -65,29 +80,236 @@ namespace net
             return true;
         }
 
-        size_t write(const std::vector<uint8_t>& data, std::error_code& ec)
+        // 读写期限由套接字的 SO_RCVTIMEO/SO_SNDTIMEO 实现
+        void set_read_timeout(std::chrono::milliseconds timeout) { set_timeout(SO_RCVTIMEO, timeout); }
+        void set_write_timeout(std::chrono::milliseconds timeout) { set_timeout(SO_SNDTIMEO, timeout); }
+
+        // 该平台没有固定文件表
+        bool register_fixed(std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        size_t write(ConstBuffer data, std::error_code& ec)
         {
             int result = ::send(socket_, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()), 0);
             if (result == SOCKET_ERROR)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = transfer_error();
                 return 0;
             }
             return static_cast<size_t>(result);
         }
 
-        size_t read(std::vector<uint8_t>& buffer, std::error_code& ec)
+        // 该平台没有零拷贝发送，退化为普通写入
+        size_t write_zero_copy(ConstBuffer data, std::error_code& ec)
+        {
+            return write(data, ec);
+        }
+
+        void set_zero_copy_threshold(size_t) {}
+
+        // 该平台没有 splice
+        static SpliceStats splice_bidirectional(Impl&, Impl&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return SpliceStats();
+        }
+
+        // 用 TransmitFile 发送文件，偏移量通过 OVERLAPPED 指定，不改变文件指针
+        // 单次调用最多发送 2^31 - 2 个字节，更大的范围分块发送
+        size_t send_file(int file_fd, uint64_t offset, size_t length, std::error_code& ec)
+        {
+            static constexpr size_t kTransmitChunk = 1u << 30;
+
+            HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(file_fd));
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                ec = std::make_error_code(std::errc::bad_file_descriptor);
+                return 0;
+            }
+
+            HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (!event)
+            {
+                ec.assign(static_cast<int>(GetLastError()), std::system_category());
+                return 0;
+            }
+
+            size_t sent = 0;
+            while (sent < length)
+            {
+                uint64_t position = offset + sent;
+                DWORD chunk = static_cast<DWORD>(std::min(length - sent, kTransmitChunk));
+                OVERLAPPED overlapped = {};
+                overlapped.Offset = static_cast<DWORD>(position);
+                overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+                // 事件句柄最低位置 1，完成时不投递到套接字关联的完成端口
+                overlapped.hEvent = reinterpret_cast<HANDLE>(reinterpret_cast<ULONG_PTR>(event) | 1);
+                ResetEvent(event);
+
+                if (!TransmitFile(socket_, file, chunk, 0, &overlapped, nullptr, 0) && WSAGetLastError() != WSA_IO_PENDING)
+                {
+                    ec = transfer_error();
+                    break;
+                }
+
+                DWORD bytes_sent = 0;
+                DWORD flags = 0;
+                if (!WSAGetOverlappedResult(socket_, &overlapped, &bytes_sent, TRUE, &flags))
+                {
+                    ec = transfer_error();
+                    break;
+                }
+                sent += bytes_sent;
+
+                // 文件已经结束
+                if (bytes_sent < chunk)
+                    break;
+            }
+            CloseHandle(event);
+            return sent;
+        }
+
+        size_t read(MutableBuffer buffer, std::error_code& ec)
         {
             int result = ::recv(socket_, reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0);
             if (result == SOCKET_ERROR)
             {
-                ec = std::make_error_code(std::errc::io_error);
+                ec = transfer_error();
                 return 0;
             }
             return static_cast<size_t>(result);
         }
 
+        // 该平台没有内核提供的缓冲区环
+        ProvidedBuffer read(BufferRing&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return ProvidedBuffer();
+        }
+
+        size_t read_multishot(BufferRing&, std::vector<ProvidedBuffer>&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 该平台没有固定缓冲区
+        size_t write_fixed(const FixedBuffer&, size_t, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        size_t read_fixed(FixedBuffer&, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return 0;
+        }
+
+        // 分散/聚集写入
+        size_t writev(const ConstBuffer* buffers, size_t count, std::error_code& ec)
+        {
+            std::vector<WSABUF> wsabufs(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                wsabufs[i].buf = reinterpret_cast<char*>(const_cast<uint8_t*>(buffers[i].data()));
+                wsabufs[i].len = static_cast<ULONG>(buffers[i].size());
+            }
+
+            DWORD bytes_sent = 0;
+            if (WSASend(socket_, wsabufs.data(), static_cast<DWORD>(count), &bytes_sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                ec = transfer_error();
+                return 0;
+            }
+            return static_cast<size_t>(bytes_sent);
+        }
+
+        // 分散读取
+        size_t readv(const MutableBuffer* buffers, size_t count, std::error_code& ec)
+        {
+            std::vector<WSABUF> wsabufs(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                wsabufs[i].buf = reinterpret_cast<char*>(buffers[i].data());
+                wsabufs[i].len = static_cast<ULONG>(buffers[i].size());
+            }
+
+            DWORD bytes_received = 0;
+            DWORD flags = 0;
+            if (WSARecv(socket_, wsabufs.data(), static_cast<DWORD>(count), &bytes_received, &flags, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                ec = transfer_error();
+                return 0;
+            }
+            return static_cast<size_t>(bytes_received);
+        }
+
+        // 该平台的事件循环不分发完成事件，不支持异步提交
+        bool start_read(MutableBuffer, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_write(ConstBuffer, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_connect(const SocketAddr&, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
+        bool start_connect(const SocketAddr&, sockaddr_storage&, IoOperation*, std::error_code& ec)
+        {
+            ec = std::make_error_code(std::errc::operation_not_supported);
+            return false;
+        }
+
     private:
+        // 等待非阻塞连接完成，超时时 ec 为 timed_out
+        bool wait_connected(std::chrono::milliseconds timeout, std::error_code& ec)
+        {
+            fd_set writable;
+            fd_set failed;
+            FD_ZERO(&writable);
+            FD_ZERO(&failed);
+            FD_SET(socket_, &writable);
+            FD_SET(socket_, &failed);
+            timeval tv = {};
+            tv.tv_sec = static_cast<long>(timeout.count() / 1000);
+            tv.tv_usec = static_cast<long>(timeout.count() % 1000 * 1000);
+
+            int ready = select(0, nullptr, &writable, &failed, &tv);
+            if (ready == 0)
+            {
+                ec = std::make_error_code(std::errc::timed_out);
+                return false;
+            }
+            return ready > 0 && FD_ISSET(socket_, &writable);
+        }
+
+        // 读写失败时的错误码，超过 SO_RCVTIMEO/SO_SNDTIMEO 时为 WSAETIMEDOUT
+        static std::error_code transfer_error()
+        {
+            if (WSAGetLastError() == WSAETIMEDOUT)
+                return std::make_error_code(std::errc::timed_out);
+            return std::make_error_code(std::errc::io_error);
+        }
+
+        void set_timeout(int option, std::chrono::milliseconds timeout)
+        {
+            DWORD value = static_cast<DWORD>(timeout.count());
+            setsockopt(socket_, SOL_SOCKET, option, reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
         SOCKET socket_ = INVALID_SOCKET; // 初始为无效套接字
     };
 
@@ -0,0 +1,197 @@
+#include "TimerWheel.h"
+
+namespace net
+{
+    TimerWheel::Entry::~Entry()
+    {
+        if (wheel_)
+        {
+            wheel_->cancel(*this);
+        }
+    }
+
+    // 创建所有槽位的哨兵节点
+    TimerWheel::TimerWheel(std::chrono::milliseconds resolution, Clock::time_point now)
+        : slots_(new Entry[kLevels * kSlots]), start_(now), resolution_(resolution)
+    {
+        if (resolution_.count() <= 0)
+        {
+            resolution_ = Clock::duration(1);
+        }
+        for (unsigned i = 0; i < kLevels * kSlots; ++i)
+        {
+            slots_[i].prev_ = &slots_[i];
+            slots_[i].next_ = &slots_[i];
+        }
+    }
+
+    // 仍在登记中的条目与时间轮脱离，之后析构时不再访问时间轮
+    TimerWheel::~TimerWheel()
+    {
+        for (unsigned i = 0; i < kLevels * kSlots; ++i)
+        {
+            Entry& head = slots_[i];
+            for (Entry* entry = head.next_; entry != &head; entry = entry->next_)
+            {
+                entry->wheel_ = nullptr;
+            }
+        }
+    }
+
+    // 登记或刷新条目
+    void TimerWheel::schedule(Entry& entry, std::chrono::milliseconds timeout)
+    {
+        Clock::duration duration = timeout;
+        uint64_t ticks = duration.count() > 0 ? static_cast<uint64_t>((duration + resolution_ - Clock::duration(1)) / resolution_) : 1;
+        uint64_t expiry = now_ + ticks;
+
+        // 推迟到期时间时留在原槽位，槽位被处理时再按新的到期时间放置
+        if (entry.wheel_ == this && expiry >= entry.slot_expiry_)
+        {
+            entry.expiry_ = expiry;
+            return;
+        }
+
+        if (entry.wheel_)
+        {
+            entry.wheel_->cancel(entry);
+        }
+        entry.expiry_ = expiry;
+        entry.wheel_ = this;
+        insert(entry);
+        ++size_;
+    }
+
+    // 取消登记
+    void TimerWheel::cancel(Entry& entry)
+    {
+        if (entry.wheel_ != this)
+        {
+            return;
+        }
+        unlink(entry);
+        entry.wheel_ = nullptr;
+        --size_;
+    }
+
+    // 推进时间轮，逐个刻度处理经过的槽位
+    size_t TimerWheel::advance(Clock::time_point now, std::vector<Entry*>& expired)
+    {
+        uint64_t target = now > start_ ? static_cast<uint64_t>((now - start_) / resolution_) : 0;
+        size_t before = expired.size();
+
+        while (now_ < target && size_ > 0)
+        {
+            ++now_;
+
+            // 低位归零时先把高层对应槽位的条目分配到低层，从最高层开始
+            for (unsigned level = kLevels - 1; level > 0; --level)
+            {
+                if ((now_ & ((uint64_t(1) << (level * kSlotBits)) - 1)) == 0)
+                {
+                    process(slot(level, now_), expired);
+                }
+            }
+            process(slot(0, now_), expired);
+        }
+
+        // 没有条目时直接跳到目标刻度
+        if (now_ < target)
+        {
+            now_ = target;
+        }
+        return expired.size() - before;
+    }
+
+    // 下一个非空的底层槽位，或者下一次高层槽位下放的时间
+    TimerWheel::Clock::time_point TimerWheel::next_deadline() const
+    {
+        if (size_ == 0)
+        {
+            return Clock::time_point::max();
+        }
+
+        uint64_t tick = now_ + 1;
+        for (; (tick & (kSlots - 1)) != 0; ++tick)
+        {
+            Entry& head = slot(0, tick);
+            if (head.next_ != &head)
+            {
+                break;
+            }
+        }
+        return start_ + resolution_ * static_cast<Clock::rep>(tick);
+    }
+
+    TimerWheel::Entry& TimerWheel::slot(unsigned level, uint64_t tick) const
+    {
+        unsigned index = static_cast<unsigned>((tick >> (level * kSlotBits)) & (kSlots - 1));
+        return slots_[level * kSlots + index];
+    }
+
+    // 按距离到期的刻度数选择层级：距离小于 256^(level+1) 的放入第 level 层
+    void TimerWheel::insert(Entry& entry)
+    {
+        static constexpr uint64_t kMaxDelta = (uint64_t(1) << (kLevels * kSlotBits)) - 1;
+
+        uint64_t delta = entry.expiry_ > now_ ? entry.expiry_ - now_ : 1;
+        if (delta > kMaxDelta)
+        {
+            delta = kMaxDelta;
+        }
+        uint64_t expiry = now_ + delta;
+
+        unsigned level = 0;
+        while (level + 1 < kLevels && delta >= (uint64_t(1) << ((level + 1) * kSlotBits)))
+        {
+            ++level;
+        }
+
+        // 高层槽位在对应位以下全为 0 的刻度被处理
+        unsigned shift = level * kSlotBits;
+        entry.slot_expiry_ = (expiry >> shift) << shift;
+        link(slot(level, expiry), entry);
+    }
+
+    // 处理一个槽位：到期的条目取消登记并交给调用者，其余的按剩余时间重新放置
+    void TimerWheel::process(Entry& head, std::vector<Entry*>& expired)
+    {
+        Entry* entry = head.next_;
+        head.prev_ = &head;
+        head.next_ = &head;
+
+        while (entry != &head)
+        {
+            Entry* next = entry->next_;
+            if (entry->expiry_ <= now_)
+            {
+                entry->prev_ = nullptr;
+                entry->next_ = nullptr;
+                entry->wheel_ = nullptr;
+                --size_;
+                expired.push_back(entry);
+            }
+            else
+            {
+                insert(*entry);
+            }
+            entry = next;
+        }
+    }
+
+    void TimerWheel::link(Entry& head, Entry& entry)
+    {
+        entry.prev_ = head.prev_;
+        entry.next_ = &head;
+        head.prev_->next_ = &entry;
+        head.prev_ = &entry;
+    }
+
+    void TimerWheel::unlink(Entry& entry)
+    {
+        entry.prev_->next_ = entry.next_;
+        entry.next_->prev_ = entry.prev_;
+        entry.prev_ = nullptr;
+        entry.next_ = nullptr;
+    }
+}